@@ -42,7 +42,8 @@ module rv_blinky (
       .FWD        (0),
       .BPRED      (0),
       .PC_REG     (0),
-      .IMEM_INIT  (".build/sw/rv32i/blinky/blinky.hex")
+      .IMEM_INIT  (".build/sw/rv32i/blinky/blinky.hex"),
+      .DMEM_INIT  (".build/sw/rv32i/blinky/blinky_dmem.hex")
   ) soc (
       .clk     (clk),
       .rst_n   (rst_n),
@@ -66,18 +67,20 @@ module rv_blinky (
   // Instantiate the I/O register bank
   //
   svc_soc_io_reg io_regs (
-      .clk     (clk),
-      .rst_n   (rst_n),
-      .io_wen  (io_wen),
-      .io_waddr(io_waddr),
-      .io_wdata(io_wdata),
-      .io_wstrb(io_wstrb),
-      .io_ren  (io_ren),
-      .io_raddr(io_raddr),
-      .io_rdata(io_rdata),
-      .led     (led),
-      .gpio    (gpio),
-      .uart_tx (uart_tx_unused)
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (led),
+      .gpio       (gpio),
+      .uart_tx    (uart_tx_unused),
+      // Stall events come from RVFI, so only svc_soc_sim counts them
+      .perf_events('0)
   );
 
 endmodule
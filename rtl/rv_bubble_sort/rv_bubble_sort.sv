@@ -35,8 +35,8 @@ module rv_bubble_sort #(
   //
   // Instantiate the RISC-V SoC with bubble_sort program
   //
-  // Note: Both IMEM and DMEM initialized with same hex file
-  // This allows program to access data from DMEM
+  // Note: bubble_sort is linked with the split layout (SVC_SPLIT_MEM), so
+  // DMEM gets its own image with .rodata and .data
   //
   svc_rv_soc_bram #(
       .XLEN       (32),
@@ -48,7 +48,7 @@ module rv_bubble_sort #(
       .BPRED      (1),
       .PC_REG     (0),
       .IMEM_INIT  (".build/sw/rv32i/bubble_sort/bubble_sort.hex"),
-      .DMEM_INIT  (".build/sw/rv32i/bubble_sort/bubble_sort.hex")
+      .DMEM_INIT  (".build/sw/rv32i/bubble_sort/bubble_sort_dmem.hex")
   ) soc (
       .clk     (clk),
       .rst_n   (rst_n),
@@ -71,18 +71,20 @@ module rv_bubble_sort #(
       .BAUD_RATE (BAUD_RATE),
       .MEM_TYPE  (1)
   ) io_regs (
-      .clk     (clk),
-      .rst_n   (rst_n),
-      .io_wen  (io_wen),
-      .io_waddr(io_waddr),
-      .io_wdata(io_wdata),
-      .io_wstrb(io_wstrb),
-      .io_ren  (io_ren),
-      .io_raddr(io_raddr),
-      .io_rdata(io_rdata),
-      .led     (),
-      .gpio    (),
-      .uart_tx (uart_tx)
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (),
+      .gpio       (),
+      .uart_tx    (uart_tx),
+      // Stall events come from RVFI, so only svc_soc_sim counts them
+      .perf_events('0)
   );
 
 
@@ -7,12 +7,14 @@
 //
 // Architecture-generic: hex file path set by Makefile via RV_COREMARK_HEX define
 //
-// Note: CoreMark requires hardware multiply (M extension or Zmmul)
+// Note: CoreMark is multiply-heavy. The RV32I variant runs on the libsvc
+// soft multiply runtime and is several times slower than hardware multiply.
 //
 // Usage:
 //   make sw
 //   make rv_coremark_im_sim       # RV32IM variant (recommended)
 //   make rv_coremark_i_zmmul_sim  # RV32I_Zmmul variant (hardware multiply)
+//   make rv_coremark_i_sim        # RV32I variant (soft multiply)
 //
 module rv_coremark_sim;
   //
@@ -38,8 +40,8 @@ module rv_coremark_sim;
       .IMEM_DEPTH     (IMEM_DEPTH),
       .DMEM_DEPTH     (DMEM_DEPTH),
       .IMEM_INIT      (MEM_INIT),
-      .DMEM_INIT      (MEM_INIT),
-      .DMEM_INIT_128  (MEM_INIT),
+      .DMEM_INIT      (DMEM_MEM_INIT),
+      .DMEM_INIT_128  (DMEM_MEM_INIT_128),
       // CPU architecture (from rv_sim_config.svh)
       .MEM_TYPE       (MEM_TYPE),
       .PIPELINED      (PIPELINED),
@@ -44,7 +44,7 @@ module rv_dhrystone #(
       .BPRED      (0),
       .PC_REG     (0),
       .IMEM_INIT  (".build/sw/rv32i/dhrystone/dhrystone.hex"),
-      .DMEM_INIT  (".build/sw/rv32i/dhrystone/dhrystone.hex")
+      .DMEM_INIT  (".build/sw/rv32i/dhrystone/dhrystone_dmem.hex")
   ) soc (
       .clk     (clk),
       .rst_n   (rst_n),
@@ -67,18 +67,20 @@ module rv_dhrystone #(
       .BAUD_RATE (BAUD_RATE),
       .MEM_TYPE  (1)
   ) io_regs (
-      .clk     (clk),
-      .rst_n   (rst_n),
-      .io_wen  (io_wen),
-      .io_waddr(io_waddr),
-      .io_wdata(io_wdata),
-      .io_wstrb(io_wstrb),
-      .io_ren  (io_ren),
-      .io_raddr(io_raddr),
-      .io_rdata(io_rdata),
-      .led     (),
-      .gpio    (),
-      .uart_tx (uart_tx)
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (),
+      .gpio       (),
+      .uart_tx    (uart_tx),
+      // Stall events come from RVFI, so only svc_soc_sim counts them
+      .perf_events('0)
   );
 
 endmodule
@@ -36,8 +36,8 @@ module rv_dhrystone_sim;
       .IMEM_DEPTH     (IMEM_DEPTH),
       .DMEM_DEPTH     (DMEM_DEPTH),
       .IMEM_INIT      (MEM_INIT),
-      .DMEM_INIT      (MEM_INIT),
-      .DMEM_INIT_128  (MEM_INIT),
+      .DMEM_INIT      (DMEM_MEM_INIT),
+      .DMEM_INIT_128  (DMEM_MEM_INIT_128),
       // CPU architecture (from rv_sim_config.svh)
       .MEM_TYPE       (MEM_TYPE),
       .PIPELINED      (PIPELINED),
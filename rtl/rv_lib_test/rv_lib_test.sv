@@ -36,15 +36,15 @@ module rv_lib_test #(
   //
   svc_rv_soc_bram #(
       .XLEN       (32),
-      .IMEM_DEPTH (4096),
-      .DMEM_DEPTH (4096),
+      .IMEM_DEPTH (6144),
+      .DMEM_DEPTH (6144),
       .PIPELINED  (1),
       .FWD_REGFILE(1),
       .FWD        (0),
       .BPRED      (0),
       .PC_REG     (0),
       .IMEM_INIT  (".build/sw/rv32i/lib_test/lib_test.hex"),
-      .DMEM_INIT  (".build/sw/rv32i/lib_test/lib_test.hex")
+      .DMEM_INIT  (".build/sw/rv32i/lib_test/lib_test_dmem.hex")
   ) soc (
       .clk     (clk),
       .rst_n   (rst_n),
@@ -67,18 +67,20 @@ module rv_lib_test #(
       .BAUD_RATE (BAUD_RATE),
       .MEM_TYPE  (1)
   ) io_regs (
-      .clk     (clk),
-      .rst_n   (rst_n),
-      .io_wen  (io_wen),
-      .io_waddr(io_waddr),
-      .io_wdata(io_wdata),
-      .io_wstrb(io_wstrb),
-      .io_ren  (io_ren),
-      .io_raddr(io_raddr),
-      .io_rdata(io_rdata),
-      .led     (),
-      .gpio    (),
-      .uart_tx (uart_tx)
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (),
+      .gpio       (),
+      .uart_tx    (uart_tx),
+      // Stall events come from RVFI, so only svc_soc_sim counts them
+      .perf_events('0)
   );
 
 endmodule
@@ -22,7 +22,7 @@ module rv_lib_test_sim;
   //
   // Program-specific configuration
   //
-  localparam int WATCHDOG_CYCLES = 2_000_000;  // Increased for malloc tests
+  localparam int WATCHDOG_CYCLES = 8_000_000;  // Increased for malloc and divmod tests
 
   //
   // SOC simulation with CPU, peripherals, and lifecycle management
@@ -35,8 +35,8 @@ module rv_lib_test_sim;
       .IMEM_DEPTH     (IMEM_DEPTH),
       .DMEM_DEPTH     (DMEM_DEPTH),
       .IMEM_INIT      (MEM_INIT),
-      .DMEM_INIT      (MEM_INIT),
-      .DMEM_INIT_128  (MEM_INIT),
+      .DMEM_INIT      (DMEM_MEM_INIT),
+      .DMEM_INIT_128  (DMEM_MEM_INIT_128),
       // CPU architecture (from rv_sim_config.svh)
       .MEM_TYPE       (MEM_TYPE),
       .PIPELINED      (PIPELINED),
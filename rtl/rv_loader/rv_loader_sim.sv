@@ -19,6 +19,9 @@
 // Then in another terminal:
 //   python3 ./scripts/rv_loader.py -p /dev/pts/N --run program.elf
 //
+// make rv_loader_test does this for each set of loader options
+// (scripts/rv_loader_test).
+//
 module rv_loader_sim;
   //
   // Shared configuration from Makefile defines
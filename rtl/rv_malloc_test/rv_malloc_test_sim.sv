@@ -0,0 +1,67 @@
+`include "svc.sv"
+
+`include "svc_soc_sim.sv"
+
+//
+// Standalone interactive simulation for RISC-V malloc replacement test
+//
+// Architecture-generic: hex file path set by Makefile via RV_MALLOC_TEST_HEX define
+//
+// Usage:
+//   make sw
+//   make rv_malloc_test_i_sim        # RV32I variant
+//   make rv_malloc_test_im_sim       # RV32IM variant
+//   make rv_malloc_test_i_zmmul_sim  # RV32I_Zmmul variant (hardware multiply)
+//
+module rv_malloc_test_sim;
+  //
+  // Shared configuration from Makefile defines
+  //
+  `include "rv_sim_config.svh"
+
+  //
+  // Program-specific configuration
+  //
+  localparam int WATCHDOG_CYCLES = 2_000_000;  // 80ms at 25MHz
+
+  //
+  // SOC simulation with CPU, peripherals, and lifecycle management
+  //
+  svc_soc_sim #(
+      // Clock and timing
+      .CLOCK_FREQ     (25_000_000),
+      .WATCHDOG_CYCLES(WATCHDOG_CYCLES),
+      // Memory configuration
+      .IMEM_DEPTH     (IMEM_DEPTH),
+      .DMEM_DEPTH     (DMEM_DEPTH),
+      .IMEM_INIT      (MEM_INIT),
+      .DMEM_INIT      (DMEM_MEM_INIT),
+      .DMEM_INIT_128  (DMEM_MEM_INIT_128),
+      // CPU architecture (from rv_sim_config.svh)
+      .MEM_TYPE       (MEM_TYPE),
+      .PIPELINED      (PIPELINED),
+      .FWD_REGFILE    (FWD_REGFILE),
+      .FWD            (FWD),
+      .BPRED          (BPRED),
+      .BTB_ENABLE     (BTB_ENABLE),
+      .RAS_ENABLE     (RAS_ENABLE),
+      .RAS_DEPTH      (RAS_DEPTH),
+      .PC_REG         (PC_REG),
+      .EXT_ZMMUL      (EXT_ZMMUL),
+      .EXT_M          (EXT_M),
+      // Peripherals
+      .BAUD_RATE      (115_200),
+      // Debug/reporting
+      .PREFIX         ("malloc"),
+      .SW_PATH        ("sw/malloc_test/main.c")
+  ) sim ();
+
+  //
+  // Optional: Generate VCD for waveform viewing
+  //
+  // initial begin
+  //   $dumpfile("rv_malloc_test_sim.vcd");
+  //   $dumpvars(0, rv_malloc_test_sim);
+  // end
+
+endmodule
@@ -0,0 +1,828 @@
+`ifndef SVC_SOC_DBG_EXT_SV
+`define SVC_SOC_DBG_EXT_SV
+
+`include "svc.sv"
+
+//
+// Debug loader protocol extension
+//
+// Sits between the debug UART and svc_rv_dbg_bridge and implements the
+// loader commands the bridge itself does not know (docs/rv_loader.md):
+//
+// - 0x00-0x03 are passed through to the bridge, and its response back
+// - 0x04 sequenced bursts are written as 0x03 bursts and acked with their
+//   sequence number. Every burst is acked, which is what cumulative acks
+//   degrade to.
+// - 0x05 compressed bursts are decoded into a 0x03 burst, acked like 0x04
+// - 0x06 block CRCs are computed over the read port, a word per three
+//   cycles, with zlib's CRC-32 (reflected 0xEDB88320, init and final xor
+//   0xFFFFFFFF, bytes LSB first)
+// - 0x07 fills are written as 0x03 bursts of the value, up to 65535 words
+//   each, and acked like 0x04
+// - 0x08/0x09 reads go over the read port, the status first and then the
+//   words
+// - 0x0A reports the supported extensions as a bitmap (CAP_*), so the
+//   loader can fall back to plain bursts on a bridge without them, and
+//   log2 of RX_FIFO_DEPTH
+//
+// Commands run one at a time. The UART cannot be stalled, so bytes that
+// arrive meanwhile wait in an RX FIFO. Words go to the bridge at a byte
+// per cycle, far faster than the UART delivers them, but a compressed
+// burst or a fill can take much longer to write than to receive, and the
+// host keeps sending behind it. RX_FIFO_DEPTH has to hold what the host
+// may have unacked, so 0x0A reports it and the loader keeps the bytes of
+// its window of bursts within it.
+//
+// The bridge cannot read memory, so the read port goes to the memories
+// directly: rd_data must hold the word at rd_idx of IMEM (rd_imem) or DMEM
+// the cycle after rd_en. Without one (READ_ENABLE = 0) 0x06, 0x08 and 0x09
+// are left out of the bitmap and answered with an error.
+//
+module svc_soc_dbg_ext #(
+    parameter int RX_FIFO_DEPTH = 1024,
+    parameter int IMEM_DEPTH    = 1024,
+    parameter int DMEM_DEPTH    = 1024,
+    parameter bit READ_ENABLE   = 1'b1
+) (
+    input logic clk,
+    input logic rst_n,
+
+    // Host side (debug UART)
+    input  logic       urx_valid,
+    input  logic [7:0] urx_data,
+    output logic       urx_ready,
+
+    output logic       utx_valid,
+    output logic [7:0] utx_data,
+    input  logic       utx_ready,
+
+    // Bridge side (svc_rv_dbg_bridge UART ports)
+    output logic       brx_valid,
+    output logic [7:0] brx_data,
+    input  logic       brx_ready,
+
+    input  logic       btx_valid,
+    input  logic [7:0] btx_data,
+    output logic       btx_ready,
+
+    // Memory read port, bridge address space mapped to IMEM/DMEM words
+    output logic        rd_en,
+    output logic        rd_imem,
+    output logic [31:0] rd_idx,
+    input  logic [31:0] rd_data
+);
+  localparam int FAW = $clog2(RX_FIFO_DEPTH);
+
+  //
+  // The pointers wrap at RX_FIFO_DEPTH and 0x0A reports it as a log2, so
+  // it must be a power of two
+  //
+  if (RX_FIFO_DEPTH < 16 ||
+      (RX_FIFO_DEPTH & (RX_FIFO_DEPTH - 1)) != 0) begin : gen_bad_rx_fifo
+    $fatal(1, "SVC_SOC_DBG_EXT: RX_FIFO_DEPTH %0d not a power of two >= 16",
+           RX_FIFO_DEPTH);
+  end
+
+  // The bridge's address space: IMEM at 0, DMEM right after it
+  localparam logic [33:0] IMEM_BYTES = 34'(IMEM_DEPTH) * 34'd4;
+  localparam logic [33:0] MEM_BYTES = IMEM_BYTES + 34'(DMEM_DEPTH) * 34'd4;
+
+  localparam logic [7:0] MAGIC_CMD = 8'hDB;
+  localparam logic [7:0] MAGIC_RSP = 8'hBD;
+
+  localparam logic [7:0] OP_READ_CTRL = 8'h00;
+  localparam logic [7:0] OP_WRITE_CTRL = 8'h01;
+  localparam logic [7:0] OP_WRITE_MEM = 8'h02;
+  localparam logic [7:0] OP_WRITE_BURST = 8'h03;
+  localparam logic [7:0] OP_WRITE_BURST_SEQ = 8'h04;
+  localparam logic [7:0] OP_WRITE_BURST_Z = 8'h05;
+  localparam logic [7:0] OP_BLOCK_CRC = 8'h06;
+  localparam logic [7:0] OP_FILL = 8'h07;
+  localparam logic [7:0] OP_READ_MEM = 8'h08;
+  localparam logic [7:0] OP_READ_BURST = 8'h09;
+  localparam logic [7:0] OP_CAPS = 8'h0A;
+
+  localparam logic [7:0] CAP_SEQ = 8'h01;
+  localparam logic [7:0] CAP_Z = 8'h02;
+  localparam logic [7:0] CAP_CRC = 8'h04;
+  localparam logic [7:0] CAP_FILL = 8'h08;
+  localparam logic [7:0] CAP_READ = 8'h10;
+  localparam logic [7:0] CAPS = (CAP_SEQ | CAP_Z | CAP_FILL |
+                                 (READ_ENABLE ? CAP_CRC | CAP_READ : 8'h00));
+
+  localparam logic [31:0] CRC_POLY = 32'hEDB88320;
+
+  // Compressed burst token tags
+  localparam logic [1:0] Z_LITERAL = 2'b00;
+  localparam logic [1:0] Z_REPEAT = 2'b01;
+  localparam logic [1:0] Z_ZERO = 2'b10;
+  localparam logic [1:0] Z_COPY = 2'b11;
+
+  typedef enum {
+    STATE_IDLE,
+    STATE_OP,
+    STATE_HDR,
+    STATE_DISPATCH,
+    STATE_PRE,
+    STATE_FWD,
+    STATE_RELAY,
+    STATE_SWALLOW,
+    STATE_ACK,
+    STATE_RSP,
+    STATE_Z_TAG,
+    STATE_Z_WORD,
+    STATE_Z_DIST,
+    STATE_Z_OUT,
+    STATE_Z_END,
+    STATE_CRC_BLOCK,
+    STATE_CRC_WORD,
+    STATE_READ_WORD,
+    STATE_RD,
+    STATE_RD_DATA,
+    STATE_FILL,
+    STATE_FILL_WORD
+  } state_t;
+
+  state_t state;
+
+  //
+  // RX FIFO
+  //
+  logic   [    7:0] fifo       [RX_FIFO_DEPTH];
+  logic   [  FAW:0] fifo_wptr;
+  logic   [  FAW:0] fifo_rptr;
+  logic             fifo_empty;
+  logic             fifo_pop;
+  logic   [    7:0] in_byte;
+
+  //
+  // Command
+  //
+  logic   [    7:0] op;
+  logic   [  103:0] hdr;
+  logic   [    3:0] hdr_cnt;
+  logic   [    3:0] hdr_need;
+  logic             has_seq;
+  logic   [    7:0] seq;
+  logic   [   31:0] cmd_addr;
+  logic   [   15:0] cmd_len;
+  logic   [   15:0] cmd_zlen;
+  logic   [   15:0] cmd_count;
+  logic   [   31:0] fill_count;
+  logic   [   31:0] fill_value;
+
+  //
+  // Byte sequencers: pre goes to the bridge, rsp to the host, both LSB
+  // first. relay_cnt counts bridge response bytes to pass on or drop.
+  //
+  logic   [   79:0] pre;
+  logic   [    3:0] pre_cnt;
+  state_t           pre_next;
+  logic   [   17:0] fwd_cnt;
+  state_t           fwd_next;
+  logic   [    1:0] relay_cnt;
+  state_t           swallow_next;
+  logic   [   31:0] rsp;
+  logic   [    2:0] rsp_cnt;
+  state_t           rsp_next;
+  logic             status;
+
+  //
+  // Compressed burst decoder. A copy may reach back 256 words into the
+  // burst's own output, kept in hist. Reaching back past the start of the
+  // burst is an error, so hist never needs clearing.
+  //
+  logic   [   31:0] hist       [    256];
+  logic   [   15:0] z_left;
+  logic   [    1:0] z_tag;
+  logic   [    6:0] z_cnt;
+  logic   [   31:0] z_word;
+  logic   [    1:0] z_bytes;
+  logic   [    8:0] z_dist;
+  logic   [   16:0] z_out;
+  logic             z_copy_bad;
+  logic   [   31:0] z_next;
+  logic             z_full;
+  state_t           z_after;
+
+  //
+  // Range of a read or fill, checked against the memories
+  //
+  logic   [   31:0] rng_words;
+  logic   [   34:0] rng_start;
+  logic   [   34:0] rng_stop;
+  logic             rng_ok;
+
+  //
+  // Reads and CRCs: rd_addr walks the range a word at a time, rd_left
+  // words to go (per block for CRCs). A range outside the memories reads
+  // as zeros, with an error status.
+  //
+  logic   [   31:0] rd_addr;
+  logic   [   15:0] rd_left;
+  logic             rd_ok;
+  logic             rd_range_ok;
+  logic   [   31:0] rd_word;
+  logic   [   31:0] crc;
+  logic   [   15:0] crc_blocks;
+
+  //
+  // Fills: fill_left words still to write from fill_addr, fill_words of
+  // them in the current burst
+  //
+  logic   [   31:0] fill_addr;
+  logic   [   31:0] fill_left;
+  logic   [   15:0] fill_chunk;
+  logic   [   15:0] fill_words;
+
+  logic             brx_free;
+  logic             utx_free;
+
+  assign brx_free   = !brx_valid || brx_ready;
+  assign utx_free   = !utx_valid || utx_ready;
+
+  //
+  // RX FIFO
+  //
+  assign fifo_empty = fifo_wptr == fifo_rptr;
+  assign urx_ready  = (fifo_wptr[FAW] == fifo_rptr[FAW] ||
+                       fifo_wptr[FAW-1:0] != fifo_rptr[FAW-1:0]);
+  assign in_byte    = fifo[fifo_rptr[FAW-1:0]];
+
+  always_ff @(posedge clk) begin
+    if (urx_valid && urx_ready) begin
+      fifo[fifo_wptr[FAW-1:0]] <= urx_data;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      fifo_wptr <= '0;
+      fifo_rptr <= '0;
+    end else begin
+      if (urx_valid && urx_ready) begin
+        fifo_wptr <= fifo_wptr + 1'b1;
+      end
+
+      if (fifo_pop) begin
+        fifo_rptr <= fifo_rptr + 1'b1;
+      end
+    end
+  end
+
+  always_comb begin
+    case (state)
+      STATE_IDLE, STATE_OP: fifo_pop = !fifo_empty;
+      STATE_HDR: fifo_pop = !fifo_empty && hdr_cnt != hdr_need;
+      STATE_FWD: fifo_pop = !fifo_empty && brx_free && fwd_cnt != 0;
+      STATE_Z_TAG, STATE_Z_WORD, STATE_Z_DIST, STATE_Z_END:
+      fifo_pop = !fifo_empty && z_left != 0;
+      default: fifo_pop = 1'b0;
+    endcase
+  end
+
+  //
+  // Header length after the opcode
+  //
+  always_comb begin
+    case (op)
+      OP_WRITE_CTRL:      hdr_need = 4'd1;
+      OP_WRITE_MEM:       hdr_need = 4'd8;
+      OP_WRITE_BURST:     hdr_need = 4'd6;
+      OP_WRITE_BURST_SEQ: hdr_need = 4'd7;
+      OP_WRITE_BURST_Z:   hdr_need = 4'd9;
+      OP_BLOCK_CRC:       hdr_need = 4'd8;
+      OP_FILL:            hdr_need = 4'd13;
+      OP_READ_MEM:        hdr_need = 4'd4;
+      OP_READ_BURST:      hdr_need = 4'd6;
+      default:            hdr_need = 4'd0;
+    endcase
+  end
+
+  //
+  // Header fields, after the sequence number if the command has one
+  //
+  assign has_seq    = (op == OP_WRITE_BURST_SEQ || op == OP_WRITE_BURST_Z ||
+                       op == OP_FILL);
+  assign seq        = hdr[7:0];
+  assign cmd_addr   = has_seq ? hdr[39:8] : hdr[31:0];
+  assign cmd_len    = has_seq ? hdr[55:40] : hdr[47:32];
+  assign cmd_zlen   = hdr[71:56];
+  assign cmd_count  = hdr[63:48];
+  assign fill_count = hdr[71:40];
+  assign fill_value = hdr[103:72];
+
+  //
+  // Next decoded word, and whether the burst already has all its words
+  //
+  assign z_copy_bad = z_tag == Z_COPY && 17'(z_dist) > z_out;
+  assign z_full     = z_out == 17'(cmd_len);
+
+  always_comb begin
+    if (z_tag != Z_COPY) begin
+      z_next = z_word;
+    end else if (z_copy_bad) begin
+      z_next = 32'h0;
+    end else begin
+      z_next = hist[z_out[7:0]-z_dist[7:0]];
+    end
+  end
+
+  //
+  // Where to go once the word is out: the next token, the next literal
+  // word, or another copy of this one
+  //
+  always_comb begin
+    if (z_cnt == 7'd1) begin
+      z_after = STATE_Z_TAG;
+    end else if (z_tag == Z_LITERAL) begin
+      z_after = STATE_Z_WORD;
+    end else begin
+      z_after = STATE_Z_OUT;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (state == STATE_Z_OUT && !z_full) begin
+      hist[z_out[7:0]] <= z_next;
+    end
+  end
+
+  //
+  // The range must be word aligned and lie within one memory
+  //
+  always_comb begin
+    case (op)
+      OP_FILL:       rng_words = fill_count;
+      OP_READ_MEM:   rng_words = 32'd1;
+      OP_READ_BURST: rng_words = 32'(cmd_len);
+      default:       rng_words = 32'(cmd_len) * 32'(cmd_count);
+    endcase
+  end
+
+  assign rng_start = {3'b000, cmd_addr};
+  assign rng_stop  = rng_start + {1'b0, rng_words, 2'b00};
+  assign rng_ok    = (rng_words != 0 && cmd_addr[1:0] == 2'b00 &&
+                      (rng_stop <= 35'(IMEM_BYTES) ||
+                       (rng_start >= 35'(IMEM_BYTES) &&
+                        rng_stop <= 35'(MEM_BYTES))));
+  assign rd_range_ok = READ_ENABLE && rng_ok;
+
+  assign fill_chunk = fill_left > 32'd65535 ? 16'd65535 : fill_left[15:0];
+
+  assign rd_en   = state == STATE_RD && rd_ok;
+  assign rd_imem = {2'b00, rd_addr} < IMEM_BYTES;
+  assign rd_idx  = (rd_imem ? {2'b00, rd_addr[31:2]} :
+                    32'(({2'b00, rd_addr} - IMEM_BYTES) >> 2));
+  assign rd_word = rd_ok ? rd_data : 32'h0;
+
+  function automatic logic [31:0] crc32_word(input logic [31:0] c,
+                                             input logic [31:0] data);
+    logic [31:0] r;
+
+    r = c ^ data;
+    for (int i = 0; i < 32; i++) begin
+      r = r[0] ? (r >> 1) ^ CRC_POLY : r >> 1;
+    end
+
+    return r;
+  endfunction
+
+  //
+  // Responses from the bridge
+  //
+  always_comb begin
+    case (state)
+      STATE_RELAY:   btx_ready = utx_free && relay_cnt != 0;
+      STATE_SWALLOW: btx_ready = relay_cnt != 0;
+      default:       btx_ready = 1'b0;
+    endcase
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      state        <= STATE_IDLE;
+      op           <= 8'h0;
+      hdr          <= '0;
+      hdr_cnt      <= 4'd0;
+      pre          <= '0;
+      pre_cnt      <= 4'd0;
+      pre_next     <= STATE_IDLE;
+      fwd_cnt      <= 18'd0;
+      fwd_next     <= STATE_IDLE;
+      relay_cnt    <= 2'd0;
+      swallow_next <= STATE_IDLE;
+      rsp          <= 32'h0;
+      rsp_cnt      <= 3'd0;
+      rsp_next     <= STATE_IDLE;
+      status       <= 1'b0;
+      z_left       <= 16'd0;
+      z_tag        <= Z_LITERAL;
+      z_cnt        <= 7'd0;
+      z_word       <= 32'h0;
+      z_bytes      <= 2'd0;
+      z_dist       <= 9'd0;
+      z_out        <= 17'd0;
+      rd_addr      <= 32'h0;
+      rd_ok        <= 1'b0;
+      crc          <= 32'h0;
+      crc_blocks   <= 16'd0;
+      rd_left      <= 16'd0;
+      fill_addr    <= 32'h0;
+      fill_left    <= 32'h0;
+      fill_words   <= 16'd0;
+      brx_valid    <= 1'b0;
+      brx_data     <= 8'h0;
+      utx_valid    <= 1'b0;
+      utx_data     <= 8'h0;
+    end else begin
+      if (brx_valid && brx_ready) begin
+        brx_valid <= 1'b0;
+      end
+
+      if (utx_valid && utx_ready) begin
+        utx_valid <= 1'b0;
+      end
+
+      case (state)
+        STATE_IDLE: begin
+          if (fifo_pop && in_byte == MAGIC_CMD) begin
+            state <= STATE_OP;
+          end
+        end
+
+        STATE_OP: begin
+          if (fifo_pop) begin
+            op      <= in_byte;
+            hdr_cnt <= 4'd0;
+            state   <= STATE_HDR;
+          end
+        end
+
+        STATE_HDR: begin
+          if (hdr_cnt == hdr_need) begin
+            state <= STATE_DISPATCH;
+          end else if (fifo_pop) begin
+            hdr[8*int'(hdr_cnt)+:8] <= in_byte;
+            hdr_cnt                 <= hdr_cnt + 4'd1;
+          end
+        end
+
+        STATE_DISPATCH: begin
+          status <= 1'b0;
+
+          case (op)
+            OP_READ_CTRL, OP_WRITE_CTRL, OP_WRITE_MEM, OP_WRITE_BURST: begin
+              pre       <= {hdr[63:0], op, MAGIC_CMD};
+              pre_cnt   <= 4'd2 + hdr_need;
+              relay_cnt <= op == OP_READ_CTRL ? 2'd3 : 2'd2;
+
+              if (op == OP_WRITE_BURST) begin
+                fwd_cnt  <= {cmd_len, 2'b00};
+                fwd_next <= STATE_RELAY;
+                pre_next <= STATE_FWD;
+              end else begin
+                pre_next <= STATE_RELAY;
+              end
+
+              state <= STATE_PRE;
+            end
+
+            OP_WRITE_BURST_SEQ: begin
+              if (cmd_len == 0) begin
+                state <= STATE_ACK;
+              end else begin
+                pre          <= {16'h0, cmd_len, cmd_addr, OP_WRITE_BURST,
+                                 MAGIC_CMD};
+                pre_cnt      <= 4'd8;
+                pre_next     <= STATE_FWD;
+                fwd_cnt      <= {cmd_len, 2'b00};
+                fwd_next     <= STATE_SWALLOW;
+                relay_cnt    <= 2'd2;
+                swallow_next <= STATE_ACK;
+                state        <= STATE_PRE;
+              end
+            end
+
+            //
+            // The 0x03 header goes out first, so the bridge takes the
+            // words as they are decoded
+            //
+            OP_WRITE_BURST_Z: begin
+              pre      <= {16'h0, cmd_len, cmd_addr, OP_WRITE_BURST, MAGIC_CMD};
+              pre_cnt  <= cmd_len != 0 ? 4'd8 : 4'd0;
+              pre_next <= STATE_Z_TAG;
+              z_left   <= cmd_zlen;
+              z_out    <= 17'd0;
+              state    <= STATE_PRE;
+            end
+
+            //
+            // The status goes first, then a CRC per block, zeros if the
+            // range is bad
+            //
+            OP_BLOCK_CRC: begin
+              rd_addr    <= cmd_addr;
+              rd_ok      <= rd_range_ok;
+              crc_blocks <= cmd_count;
+              rsp        <= {16'h0, 7'h0, !rd_range_ok, MAGIC_RSP};
+              rsp_cnt    <= 3'd2;
+              rsp_next   <= STATE_CRC_BLOCK;
+              state      <= STATE_RSP;
+            end
+
+            //
+            // An empty fill is acked without touching the bridge, a bad
+            // range before writing anything
+            //
+            OP_FILL: begin
+              fill_addr <= cmd_addr;
+              fill_left <= fill_count;
+
+              if (fill_count == 0) begin
+                state <= STATE_ACK;
+              end else if (!rng_ok) begin
+                status <= 1'b1;
+                state  <= STATE_ACK;
+              end else begin
+                state <= STATE_FILL;
+              end
+            end
+
+            //
+            // Like CRCs, the words follow the status even on an error
+            //
+            OP_READ_MEM, OP_READ_BURST: begin
+              rd_addr  <= cmd_addr;
+              rd_left  <= op == OP_READ_MEM ? 16'd1 : cmd_len;
+              rd_ok    <= rd_range_ok;
+              rsp      <= {16'h0, 7'h0, !rd_range_ok, MAGIC_RSP};
+              rsp_cnt  <= 3'd2;
+              rsp_next <= STATE_READ_WORD;
+              state    <= STATE_RSP;
+            end
+
+            OP_CAPS: begin
+              rsp      <= {8'(FAW), CAPS, 8'h00, MAGIC_RSP};
+              rsp_cnt  <= 3'd4;
+              rsp_next <= STATE_IDLE;
+              state    <= STATE_RSP;
+            end
+
+            default: begin
+              rsp      <= {16'h0, 8'h01, MAGIC_RSP};
+              rsp_cnt  <= 3'd2;
+              rsp_next <= STATE_IDLE;
+              state    <= STATE_RSP;
+            end
+          endcase
+        end
+
+        STATE_PRE: begin
+          if (pre_cnt == 0) begin
+            state <= pre_next;
+          end else if (brx_free) begin
+            brx_valid <= 1'b1;
+            brx_data  <= pre[7:0];
+            pre       <= {8'h0, pre[79:8]};
+            pre_cnt   <= pre_cnt - 4'd1;
+          end
+        end
+
+        STATE_FWD: begin
+          if (fwd_cnt == 0) begin
+            state <= fwd_next;
+          end else if (fifo_pop) begin
+            brx_valid <= 1'b1;
+            brx_data  <= in_byte;
+            fwd_cnt   <= fwd_cnt - 18'd1;
+          end
+        end
+
+        STATE_RELAY: begin
+          if (relay_cnt == 0) begin
+            state <= STATE_IDLE;
+          end else if (btx_valid && btx_ready) begin
+            utx_valid <= 1'b1;
+            utx_data  <= btx_data;
+            relay_cnt <= relay_cnt - 2'd1;
+          end
+        end
+
+        //
+        // The status is the second byte of the bridge's response
+        //
+        STATE_SWALLOW: begin
+          if (relay_cnt == 0) begin
+            state <= swallow_next;
+          end else if (btx_valid && btx_ready) begin
+            if (relay_cnt == 2'd1 && btx_data != 8'h00) begin
+              status <= 1'b1;
+            end
+            relay_cnt <= relay_cnt - 2'd1;
+          end
+        end
+
+        STATE_ACK: begin
+          rsp      <= {8'h0, seq, 7'h0, status, MAGIC_RSP};
+          rsp_cnt  <= 3'd3;
+          rsp_next <= STATE_IDLE;
+          state    <= STATE_RSP;
+        end
+
+        STATE_RSP: begin
+          if (rsp_cnt == 0) begin
+            state <= rsp_next;
+          end else if (utx_free) begin
+            utx_valid <= 1'b1;
+            utx_data  <= rsp[7:0];
+            rsp       <= {8'h0, rsp[31:8]};
+            rsp_cnt   <= rsp_cnt - 3'd1;
+          end
+        end
+
+        STATE_Z_TAG: begin
+          if (z_left == 0) begin
+            state <= STATE_Z_END;
+          end else if (fifo_pop) begin
+            z_left  <= z_left - 16'd1;
+            z_tag   <= in_byte[7:6];
+            z_cnt   <= {1'b0, in_byte[5:0]} + 7'd1;
+            z_word  <= 32'h0;
+            z_bytes <= 2'd0;
+
+            case (in_byte[7:6])
+              Z_LITERAL, Z_REPEAT: state <= STATE_Z_WORD;
+              Z_ZERO:              state <= STATE_Z_OUT;
+              default:             state <= STATE_Z_DIST;
+            endcase
+          end
+        end
+
+        STATE_Z_WORD: begin
+          if (z_left == 0) begin
+            status <= 1'b1;
+            state  <= STATE_Z_END;
+          end else if (fifo_pop) begin
+            z_left  <= z_left - 16'd1;
+            z_word  <= {in_byte, z_word[31:8]};
+            z_bytes <= z_bytes + 2'd1;
+
+            if (z_bytes == 2'd3) begin
+              state <= STATE_Z_OUT;
+            end
+          end
+        end
+
+        STATE_Z_DIST: begin
+          if (z_left == 0) begin
+            status <= 1'b1;
+            state  <= STATE_Z_END;
+          end else if (fifo_pop) begin
+            z_left <= z_left - 16'd1;
+            z_dist <= {1'b0, in_byte} + 9'd1;
+            state  <= STATE_Z_OUT;
+          end
+        end
+
+        //
+        // One word per visit. Words past len are dropped, and the burst
+        // is acked with an error.
+        //
+        STATE_Z_OUT: begin
+          if (z_copy_bad || z_full) begin
+            status <= 1'b1;
+          end
+
+          z_cnt <= z_cnt - 7'd1;
+
+          if (z_full) begin
+            state <= z_after;
+          end else begin
+            pre      <= {48'h0, z_next};
+            pre_cnt  <= 4'd4;
+            pre_next <= z_after;
+            z_out    <= z_out + 17'd1;
+            state    <= STATE_PRE;
+          end
+        end
+
+        //
+        // Skip whatever is left of a bad stream, then pad the burst with
+        // zeros so the bridge finishes it
+        //
+        STATE_Z_END: begin
+          if (z_left != 0) begin
+            if (fifo_pop) begin
+              z_left <= z_left - 16'd1;
+            end
+          end else if (!z_full) begin
+            status   <= 1'b1;
+            pre      <= '0;
+            pre_cnt  <= 4'd4;
+            pre_next <= STATE_Z_END;
+            z_out    <= z_out + 17'd1;
+            state    <= STATE_PRE;
+          end else if (cmd_len != 0) begin
+            relay_cnt    <= 2'd2;
+            swallow_next <= STATE_ACK;
+            state        <= STATE_SWALLOW;
+          end else begin
+            state <= STATE_ACK;
+          end
+        end
+
+        STATE_CRC_BLOCK: begin
+          if (crc_blocks == 0) begin
+            state <= STATE_IDLE;
+          end else begin
+            crc        <= 32'hFFFFFFFF;
+            rd_left    <= cmd_len;
+            crc_blocks <= crc_blocks - 16'd1;
+            state      <= STATE_CRC_WORD;
+          end
+        end
+
+        STATE_CRC_WORD: begin
+          if (rd_left == 0) begin
+            rsp      <= ~crc;
+            rsp_cnt  <= 3'd4;
+            rsp_next <= STATE_CRC_BLOCK;
+            state    <= STATE_RSP;
+          end else begin
+            state <= STATE_RD;
+          end
+        end
+
+        STATE_READ_WORD: begin
+          if (rd_left == 0) begin
+            state <= STATE_IDLE;
+          end else begin
+            state <= STATE_RD;
+          end
+        end
+
+        STATE_RD: begin
+          state <= STATE_RD_DATA;
+        end
+
+        //
+        // The word goes into the CRC, or out to the host
+        //
+        STATE_RD_DATA: begin
+          rd_left <= rd_left - 16'd1;
+          rd_addr <= rd_addr + 32'd4;
+
+          if (op == OP_BLOCK_CRC) begin
+            crc   <= crc32_word(crc, rd_word);
+            state <= STATE_CRC_WORD;
+          end else begin
+            rsp      <= rd_word;
+            rsp_cnt  <= 3'd4;
+            rsp_next <= STATE_READ_WORD;
+            state    <= STATE_RSP;
+          end
+        end
+
+        //
+        // The next burst of the fill, or the ack once it is all written
+        //
+        STATE_FILL: begin
+          if (fill_left == 0) begin
+            state <= STATE_ACK;
+          end else begin
+            pre        <= {16'h0, fill_chunk, fill_addr, OP_WRITE_BURST,
+                           MAGIC_CMD};
+            pre_cnt    <= 4'd8;
+            pre_next   <= STATE_FILL_WORD;
+            fill_words <= fill_chunk;
+            fill_left  <= fill_left - 32'(fill_chunk);
+            fill_addr  <= fill_addr + {14'h0, fill_chunk, 2'b00};
+            state      <= STATE_PRE;
+          end
+        end
+
+        STATE_FILL_WORD: begin
+          if (fill_words == 0) begin
+            relay_cnt    <= 2'd2;
+            swallow_next <= STATE_FILL;
+            state        <= STATE_SWALLOW;
+          end else begin
+            pre        <= {48'h0, fill_value};
+            pre_cnt    <= 4'd4;
+            pre_next   <= STATE_FILL_WORD;
+            fill_words <= fill_words - 16'd1;
+            state      <= STATE_PRE;
+          end
+        end
+
+        default: begin
+          state <= STATE_IDLE;
+        end
+      endcase
+    end
+  end
+
+endmodule
+
+`endif
@@ -3,14 +3,14 @@
 
 `include "svc.sv"
 `include "svc_unused.sv"
-`include "svc_uart_rx.sv"
-`include "svc_uart_tx.sv"
+`include "svc_soc_uart_rx.sv"
+`include "svc_soc_uart_tx.sv"
 
 //
 // MMIO register bank for SoC I/O
 //
 // Provides memory-mapped I/O peripherals for RISC-V SoC:
-// - UART TX for serial output
+// - UART TX/RX for serial I/O, each behind a FIFO
 // - LED control
 // - GPIO pins
 //
@@ -22,17 +22,52 @@
 //
 // Memory map:
 //   0x80000000 + 0x00: UART TX data register (write-only, bits 7:0)
-//   0x80000000 + 0x04: UART TX status register (read-only, bit 0 = TX ready)
+//   0x80000000 + 0x04: UART TX status register (read-only)
+//                        bit 0:     TX ready (FIFO not full)
+//                        bit 1:     TX idle (FIFO empty, line idle)
+//                        bits 15:8: TX FIFO free entries
 //   0x80000000 + 0x08: LED register (bit 0)
 //   0x80000000 + 0x0C: GPIO register (bits 7:0)
 //   0x80000000 + 0x10: Clock frequency register (read-only, Hz)
-//   0x80000000 + 0x14: UART RX data register (read-only, bits 7:0, read clears)
-//   0x80000000 + 0x18: UART RX status register (read-only, bit 0 = data avail)
+//   0x80000000 + 0x14: UART RX data register (read-only, bits 7:0, read pops)
+//   0x80000000 + 0x18: UART RX status register (read-only)
+//                        bit 0:     RX data available (FIFO not empty)
+//                        bits 15:8: RX FIFO level
+//   0x80000000 + 0x1C: UART TX packed data register (write-only)
+//                        Pushes each byte lane enabled in the write strobe,
+//                        lowest lane first, so one sw sends 4 bytes.
+//   0x80000000 + 0x20: UART baud divisor register (read/write, bits 15:0)
+//                        Clock cycles per bit for both directions. Resets
+//                        to CLOCK_FREQ / BAUD_RATE; writes below 4 are
+//                        ignored. Takes effect immediately, so drain TX
+//                        first.
+//   0x80000000 + 0x40-0x4C: Reserved for simulation reports (writes ignored
+//                        here, latched by svc_soc_sim)
+//   0x80000000 + 0x50-0x68: Stall attribution counters (read-only), one per
+//                        perf_events bit, counting the cycles the bit was
+//                        high:
+//                        0x50 load-use   0x54 mispredict  0x58 BTB miss
+//                        0x5C RAS miss   0x60 I-cache miss
+//                        0x64 D-cache miss  0x68 memory wait
+//   0x80000000 + 0x6C: Stall counter control (write-only)
+//                        Any write clears all stall counters.
+//
+// The FIFOs let software push a burst of bytes per status read and keep
+// receiving while it is busy. Bytes written while the TX FIFO is full are
+// dropped, so software should check the free count before a burst. The RX
+// FIFO only accepts from the receiver while it has room.
 //
 module svc_soc_io_reg #(
-    parameter     CLOCK_FREQ = 25_000_000,
-    parameter     BAUD_RATE  = 115_200,
-    parameter int MEM_TYPE   = 1
+    parameter     CLOCK_FREQ    = 25_000_000,
+    parameter     BAUD_RATE     = 115_200,
+    parameter int MEM_TYPE      = 1,
+
+    // FIFO depths (powers of two, 4 to 128)
+    parameter int TX_FIFO_DEPTH = 16,
+    parameter int RX_FIFO_DEPTH = 16,
+
+    // Stall attribution event inputs (see perf_events)
+    parameter int PERF_EVENTS = 7
 ) (
     input logic clk,
     input logic rst_n,
@@ -58,7 +93,13 @@ module svc_soc_io_reg #(
     output logic       led,
     output logic [7:0] gpio,
     output logic       uart_tx,
-    input  logic       uart_rx
+    input  logic       uart_rx,
+
+    //
+    // Stall attribution events from the CPU, one cycle per stall cycle or
+    // per miss (tie to '0 when the core doesn't provide them)
+    //
+    input logic [PERF_EVENTS-1:0] perf_events
 );
 
   //
@@ -67,6 +108,23 @@ module svc_soc_io_reg #(
   logic       led_reg;
   logic [7:0] gpio_reg;
 
+  //
+  // UART baud divisor (clock cycles per bit)
+  //
+  localparam logic [15:0] BAUD_DIV_RESET = 16'(CLOCK_FREQ / BAUD_RATE);
+
+  logic [15:0] baud_div;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      baud_div <= BAUD_DIV_RESET;
+    end else if (io_wen && io_waddr[7:0] == 8'h20) begin
+      if (io_wdata[15:0] >= 16'd4) begin
+        baud_div <= io_wdata[15:0];
+      end
+    end
+  end
+
   //
   // UART TX signals
   //
@@ -77,12 +135,10 @@ module svc_soc_io_reg #(
   //
   // UART TX instantiation
   //
-  svc_uart_tx #(
-      .CLOCK_FREQ(CLOCK_FREQ),
-      .BAUD_RATE (BAUD_RATE)
-  ) uart_tx_inst (
+  svc_soc_uart_tx uart_tx_inst (
       .clk      (clk),
       .rst_n    (rst_n),
+      .clk_div  (baud_div),
       .utx_valid(uart_tx_valid),
       .utx_data (uart_tx_data),
       .utx_ready(uart_tx_ready),
@@ -99,12 +155,10 @@ module svc_soc_io_reg #(
   //
   // UART RX instantiation
   //
-  svc_uart_rx #(
-      .CLOCK_FREQ(CLOCK_FREQ),
-      .BAUD_RATE (BAUD_RATE)
-  ) uart_rx_inst (
+  svc_soc_uart_rx uart_rx_inst (
       .clk      (clk),
       .rst_n    (rst_n),
+      .clk_div  (baud_div),
       .urx_valid(uart_rx_valid),
       .urx_data (uart_rx_data),
       .urx_ready(uart_rx_ready),
@@ -128,21 +182,152 @@ module svc_soc_io_reg #(
   end
 
   //
-  // UART TX write logic
+  // The pointers wrap at the depth and the status fields are 8 bits wide,
+  // so each FIFO must be a power of two from 4 to 128
   //
-  logic       uart_tx_write;
-  logic [7:0] io_wdata_byte;
+  if (TX_FIFO_DEPTH < 4 || TX_FIFO_DEPTH > 128 ||
+      (TX_FIFO_DEPTH & (TX_FIFO_DEPTH - 1)) != 0) begin : gen_bad_tx_fifo
+    $fatal(1, "SVC_SOC_IO_REG: TX_FIFO_DEPTH %0d not a power of two 4-128",
+           TX_FIFO_DEPTH);
+  end
 
-  assign uart_tx_write = io_wen && (io_waddr[7:0] == 8'h00);
-  assign io_wdata_byte = io_wdata[7:0];
+  if (RX_FIFO_DEPTH < 4 || RX_FIFO_DEPTH > 128 ||
+      (RX_FIFO_DEPTH & (RX_FIFO_DEPTH - 1)) != 0) begin : gen_bad_rx_fifo
+    $fatal(1, "SVC_SOC_IO_REG: RX_FIFO_DEPTH %0d not a power of two 4-128",
+           RX_FIFO_DEPTH);
+  end
+
+  //
+  // UART TX FIFO
+  //
+  // Push side: one byte from 0x00, or up to four from the packed register at
+  // 0x1C (enabled lanes compacted, lowest first). Pop side feeds the
+  // transmitter with a valid/ready handshake.
+  //
+  localparam int TX_AW = $clog2(TX_FIFO_DEPTH);
+
+  logic [    7:0] tx_mem         [TX_FIFO_DEPTH];
+  logic [TX_AW:0] tx_wptr;
+  logic [TX_AW:0] tx_rptr;
+  logic [TX_AW:0] tx_level;
+  logic [TX_AW:0] tx_free;
+  logic           tx_empty;
+  logic           tx_full;
+
+  logic [    2:0] tx_push_n;
+  logic [    7:0] tx_push_bytes  [4];
+  logic [    2:0] tx_push_accept;
+  logic           tx_pop;
+
+  assign tx_level = tx_wptr - tx_rptr;
+  assign tx_free  = (TX_AW + 1)'(TX_FIFO_DEPTH) - tx_level;
+  assign tx_empty = (tx_level == 0);
+  assign tx_full  = (tx_free == 0);
 
   always_comb begin
-    uart_tx_valid = 1'b0;
-    uart_tx_data  = 8'h00;
+    tx_push_n = 3'd0;
+    for (int i = 0; i < 4; i++) begin
+      tx_push_bytes[i] = 8'h00;
+    end
+
+    if (io_wen && io_waddr[7:0] == 8'h00) begin
+      tx_push_bytes[0] = io_wdata[7:0];
+      tx_push_n        = 3'd1;
+    end else if (io_wen && io_waddr[7:0] == 8'h1C) begin
+      for (int i = 0; i < 4; i++) begin
+        if (io_wstrb[i]) begin
+          tx_push_bytes[tx_push_n[1:0]] = io_wdata[i*8+:8];
+          tx_push_n                     = tx_push_n + 3'd1;
+        end
+      end
+    end
+  end
+
+  // Drop whatever doesn't fit
+  assign tx_push_accept = ((TX_AW + 1)'(tx_push_n) > tx_free) ? 3'(tx_free) :
+      tx_push_n;
+  assign tx_pop = uart_tx_valid && uart_tx_ready;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      tx_wptr <= '0;
+      tx_rptr <= '0;
+    end else begin
+      tx_wptr <= tx_wptr + (TX_AW + 1)'(tx_push_accept);
+      if (tx_pop) begin
+        tx_rptr <= tx_rptr + 1'b1;
+      end
+    end
+  end
 
-    if (uart_tx_write) begin
-      uart_tx_valid = 1'b1;
-      uart_tx_data  = io_wdata_byte;
+  always_ff @(posedge clk) begin
+    for (int i = 0; i < 4; i++) begin
+      if (3'(i) < tx_push_accept) begin
+        tx_mem[TX_AW'(tx_wptr + (TX_AW + 1)'(i))] <= tx_push_bytes[i];
+      end
+    end
+  end
+
+  assign uart_tx_valid = !tx_empty;
+  assign uart_tx_data  = tx_mem[tx_rptr[TX_AW-1:0]];
+
+  //
+  // UART RX FIFO
+  //
+  // Accepts from the receiver whenever there is room, and pops on a read of
+  // the RX data register.
+  //
+  localparam int RX_AW = $clog2(RX_FIFO_DEPTH);
+
+  logic [    7:0] rx_mem   [RX_FIFO_DEPTH];
+  logic [RX_AW:0] rx_wptr;
+  logic [RX_AW:0] rx_rptr;
+  logic [RX_AW:0] rx_level;
+  logic           rx_empty;
+  logic           rx_full;
+  logic           rx_push;
+  logic           rx_pop;
+
+  assign rx_level      = rx_wptr - rx_rptr;
+  assign rx_empty      = (rx_level == 0);
+  assign rx_full       = (rx_level == (RX_AW + 1)'(RX_FIFO_DEPTH));
+
+  assign uart_rx_ready = !rx_full;
+  assign rx_push       = uart_rx_valid && uart_rx_ready;
+  assign rx_pop        = io_ren && (io_raddr[7:0] == 8'h14) && !rx_empty;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      rx_wptr <= '0;
+      rx_rptr <= '0;
+    end else begin
+      if (rx_push) begin
+        rx_wptr <= rx_wptr + 1'b1;
+      end
+      if (rx_pop) begin
+        rx_rptr <= rx_rptr + 1'b1;
+      end
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (rx_push) begin
+      rx_mem[rx_wptr[RX_AW-1:0]] <= uart_rx_data;
+    end
+  end
+
+  //
+  // Stall attribution counters
+  //
+  logic [31:0] perf_cnt[PERF_EVENTS];
+
+  always_ff @(posedge clk) begin
+    for (int i = 0; i < PERF_EVENTS; i++) begin
+      if (!rst_n || (io_wen && io_waddr[7:0] == 8'h6C)) begin
+        perf_cnt[i] <= 32'h0;
+      end else if (perf_events[i]) begin
+        perf_cnt[i] <= perf_cnt[i] + 1;
+      end
     end
   end
 
@@ -171,25 +356,32 @@ module svc_soc_io_reg #(
     if (io_ren) begin
       case (raddr_sel)
         8'h00:   io_rdata_comb = 32'h0;
-        8'h04:   io_rdata_comb = {31'h0, uart_tx_ready};
+        8'h04: begin
+          io_rdata_comb[0]    = !tx_full;
+          io_rdata_comb[1]    = tx_empty && uart_tx_ready;
+          io_rdata_comb[15:8] = 8'(tx_free);
+        end
         8'h08:   io_rdata_comb = {31'h0, led_reg};
         8'h0C:   io_rdata_comb = {24'h0, gpio_reg};
         8'h10:   io_rdata_comb = CLOCK_FREQ;
-        8'h14:   io_rdata_comb = {24'h0, uart_rx_data};
-        8'h18:   io_rdata_comb = {31'h0, uart_rx_valid};
-        default: io_rdata_comb = 32'h0;
+        8'h14:   io_rdata_comb = {24'h0, rx_mem[rx_rptr[RX_AW-1:0]]};
+        8'h18: begin
+          io_rdata_comb[0]    = !rx_empty;
+          io_rdata_comb[15:8] = 8'(rx_level);
+        end
+        8'h20:   io_rdata_comb = {16'h0, baud_div};
+        default: begin
+          // Stall counters at 0x50 + 4 * event
+          for (int i = 0; i < PERF_EVENTS; i++) begin
+            if (raddr_sel == 8'(8'h50 + 4 * i)) begin
+              io_rdata_comb = perf_cnt[i];
+            end
+          end
+        end
       endcase
     end
   end
 
-  //
-  // UART RX ready logic
-  //
-  // Pulse ready when SW reads the RX data register to acknowledge receipt.
-  // This clears uart_rx_valid on the next cycle.
-  //
-  assign uart_rx_ready = io_ren && (raddr_sel == 8'h14);
-
   //
   // Output timing based on memory type
   //
@@ -215,7 +407,7 @@ module svc_soc_io_reg #(
     assign io_rdata = io_rdata_comb;
   end
 
-  `SVC_UNUSED({io_wstrb, io_waddr[31:8], io_wdata[31:8], io_raddr[31:8]});
+  `SVC_UNUSED({io_waddr[31:8], io_raddr[31:8]});
 
 endmodule
 
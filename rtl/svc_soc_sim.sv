@@ -6,11 +6,22 @@
 `include "svc_rv_soc_bram.sv"
 `include "svc_rv_soc_bram_cache.sv"
 `include "svc_rv_soc_sram.sv"
+`include "svc_soc_dbg_ext.sv"
 `include "svc_soc_io_reg.sv"
+`include "svc_soc_sim_perf.sv"
+`include "svc_soc_sim_prof.sv"
+`ifdef SVC_SIM_ISS
+`include "svc_soc_sim_iss.sv"
+`endif
 `include "svc_soc_sim_uart.sv"
 `include "svc_uart_rx.sv"
 `include "svc_uart_tx.sv"
 
+`ifdef SVC_SIM_FAST
+import "DPI-C" function void svc_sim_console_putc(input int c);
+import "DPI-C" function void svc_sim_console_flush();
+`endif
+
 // SOC simulation infrastructure for RISC-V CPU demos
 //
 // Provides complete SOC simulation environment with:
@@ -27,6 +38,22 @@
 //   +SVC_RV_DBG_WB=1   - Write Back stage debug
 //   +SVC_RV_DBG_HAZ=1  - Hazard detection debug
 // - Banner and statistics reporting
+// - Sampling PC profiler (builds with SVC_SIM_PROF defined, see
+//   svc_soc_sim_prof.sv): +SVC_SIM_PROF=<file> +SVC_SIM_PROF_PERIOD=<N>
+// - Stall attribution events for the io_reg counters (builds with
+//   SVC_SIM_PERF defined, see svc_soc_sim_perf.sv)
+// - Runtime watchdog override: +SVC_SIM_WATCHDOG=<cycles> (0 disables)
+// - Checkpoint/restore (builds with SVC_SIM_CKPT defined, see the
+//   checkpoint section below and libsvc/ckpt.h):
+//   +SVC_CKPT_SAVE=<file> +SVC_CKPT_AT=<cycle> +SVC_CKPT_LOAD=<file>
+// - ISS co-simulation (builds with SVC_SIM_ISS defined, see
+//   svc_soc_sim_iss.sv): +SVC_ISS_LOCKSTEP +SVC_ISS_FF=<millions>
+//
+// Fast mode (builds with SVC_SIM_FAST defined, Verilator only): console
+// output is taken from the CPU's writes to the UART TX registers and handed
+// to a DPI function, instead of sampling the TX pin bit by bit. Used by the
+// rv_*_fast_sim targets for full-length benchmark runs. Fast mode has no
+// console input, and debug-loader builds keep the bit-level UART.
 //
 // Memory type controlled by MEM_TYPE parameter (MEM_TYPE_BRAM or MEM_TYPE_SRAM)
 //
@@ -114,8 +141,21 @@ module svc_soc_sim #(
   //
   // In debug mode, the UART connects to the debug bridge instead of the
   // application. The debug bridge uses the UART for loading programs and
-  // controlling the CPU (stall/reset).
+  // controlling the CPU (stall/reset). svc_soc_dbg_ext sits in front of it
+  // and adds the loader's extended commands.
+  //
+  // The extension reads memory for block CRCs. Its read port reaches the
+  // memory arrays hierarchically like the checkpoint code; override
+  // SVC_SIM_DBG_IMEM/SVC_SIM_DBG_DMEM if they are named differently. The
+  // cache SoC has no read port (dirty lines live in the D-cache).
   //
+`ifndef SVC_SIM_DBG_IMEM
+`define SVC_SIM_DBG_IMEM rv_cpu.imem.mem
+`endif
+`ifndef SVC_SIM_DBG_DMEM
+`define SVC_SIM_DBG_DMEM rv_cpu.dmem.mem
+`endif
+
   logic       uart_rx;
   logic       uart_tx_monitored;  // What the terminal monitors (app or debug)
 
@@ -129,6 +169,17 @@ module svc_soc_sim #(
   logic       dbg_uart_tx_pin;
 
   if (DEBUG_ENABLED) begin : gen_dbg_uart
+    logic        host_urx_valid;
+    logic [ 7:0] host_urx_data;
+    logic        host_urx_ready;
+    logic        host_utx_valid;
+    logic [ 7:0] host_utx_data;
+    logic        host_utx_ready;
+    logic        dbg_rd_en;
+    logic        dbg_rd_imem;
+    logic [31:0] dbg_rd_idx;
+    logic [31:0] dbg_rd_data;
+
     // Decode terminal's TX output for debug bridge RX
     svc_uart_rx #(
         .CLOCK_FREQ(CLOCK_FREQ),
@@ -136,12 +187,59 @@ module svc_soc_sim #(
     ) dbg_uart_rx (
         .clk      (clk),
         .rst_n    (rst_n),
-        .urx_valid(dbg_urx_valid),
-        .urx_data (dbg_urx_data),
-        .urx_ready(dbg_urx_ready),
+        .urx_valid(host_urx_valid),
+        .urx_data (host_urx_data),
+        .urx_ready(host_urx_ready),
         .urx_pin  (uart_rx)
     );
 
+    // The loader keeps its unacked bytes within the depth 0x0A reports
+    svc_soc_dbg_ext #(
+        .RX_FIFO_DEPTH(131072),
+        .IMEM_DEPTH   (IMEM_DEPTH),
+        .DMEM_DEPTH   (DMEM_DEPTH),
+        .READ_ENABLE  (MEM_TYPE != MEM_TYPE_BRAM_CACHE)
+    ) dbg_ext (
+        .clk      (clk),
+        .rst_n    (rst_n),
+        .urx_valid(host_urx_valid),
+        .urx_data (host_urx_data),
+        .urx_ready(host_urx_ready),
+        .utx_valid(host_utx_valid),
+        .utx_data (host_utx_data),
+        .utx_ready(host_utx_ready),
+        .brx_valid(dbg_urx_valid),
+        .brx_data (dbg_urx_data),
+        .brx_ready(dbg_urx_ready),
+        .btx_valid(dbg_utx_valid),
+        .btx_data (dbg_utx_data),
+        .btx_ready(dbg_utx_ready),
+        .rd_en    (dbg_rd_en),
+        .rd_imem  (dbg_rd_imem),
+        .rd_idx   (dbg_rd_idx),
+        .rd_data  (dbg_rd_data)
+    );
+
+    if (MEM_TYPE == MEM_TYPE_SRAM) begin : gen_dbg_rd_sram
+      always_ff @(posedge clk) begin
+        if (dbg_rd_en) begin
+          dbg_rd_data <= (dbg_rd_imem ?
+                          sram_soc.`SVC_SIM_DBG_IMEM[dbg_rd_idx] :
+                          sram_soc.`SVC_SIM_DBG_DMEM[dbg_rd_idx]);
+        end
+      end
+    end else if (MEM_TYPE == MEM_TYPE_BRAM) begin : gen_dbg_rd_bram
+      always_ff @(posedge clk) begin
+        if (dbg_rd_en) begin
+          dbg_rd_data <= (dbg_rd_imem ?
+                          bram_soc.`SVC_SIM_DBG_IMEM[dbg_rd_idx] :
+                          bram_soc.`SVC_SIM_DBG_DMEM[dbg_rd_idx]);
+        end
+      end
+    end else begin : gen_dbg_rd_none
+      assign dbg_rd_data = 32'h0;
+    end
+
     // Encode debug bridge's TX for terminal to monitor
     svc_uart_tx #(
         .CLOCK_FREQ(CLOCK_FREQ),
@@ -149,9 +247,9 @@ module svc_soc_sim #(
     ) dbg_uart_tx (
         .clk      (clk),
         .rst_n    (rst_n),
-        .utx_valid(dbg_utx_valid),
-        .utx_data (dbg_utx_data),
-        .utx_ready(dbg_utx_ready),
+        .utx_valid(host_utx_valid),
+        .utx_data (host_utx_data),
+        .utx_ready(host_utx_ready),
         .utx_pin  (dbg_uart_tx_pin)
     );
 
@@ -166,34 +264,73 @@ module svc_soc_sim #(
     assign dbg_uart_tx_pin   = 1'b1;
   end
 
-  svc_soc_sim_uart #(
-      .CLOCK_FREQ(CLOCK_FREQ),
-      .BAUD_RATE (BAUD_RATE),
-      .PRINT_RX  (DEBUG_ENABLED ? 0 : 1),  // Don't print debug protocol bytes
-      .PREFIX    (PREFIX),
-      .IMEM_DEPTH(IMEM_DEPTH)
-  ) uart_terminal (
-      .clk    (clk),
-      .rst_n  (rst_n),
-      .urx_pin(uart_rx),
-      .utx_pin(uart_tx_monitored)
-  );
+  //
+  // Fast mode replaces the terminal with the console snoop below
+  //
+`ifdef SVC_SIM_FAST
+  localparam bit FAST_CONSOLE = (DEBUG_ENABLED == 0);
+`else
+  localparam bit FAST_CONSOLE = 0;
+`endif
+
+  if (!FAST_CONSOLE) begin : gen_uart_term
+    svc_soc_sim_uart #(
+        .CLOCK_FREQ(CLOCK_FREQ),
+        .BAUD_RATE (BAUD_RATE),
+        .PRINT_RX  (DEBUG_ENABLED ? 0 : 1),  // Don't print debug protocol bytes
+        .PREFIX    (PREFIX),
+        .IMEM_DEPTH(IMEM_DEPTH)
+    ) uart_terminal (
+        .clk    (clk),
+        .rst_n  (rst_n),
+        .urx_pin(uart_rx),
+        .utx_pin(uart_tx_monitored)
+    );
+  end else begin : gen_no_uart_term
+    assign uart_rx = 1'b1;
+  end
 
   // In debug mode, add a second terminal to monitor app's UART output to stdout
-  // (the primary terminal handles debug bridge PTY communication)
+  // (the primary terminal handles debug bridge PTY communication).
+  //
+  // With +APP_UART_STDIN it also sends stdin to the app and prints its output
+  // unfiltered, so a host tool can hold a conversation with the program
+  // (scripts/rv_loader_test relays it to rv_loader --console-port).
+  logic app_console_rx;
+
   if (DEBUG_ENABLED) begin : gen_app_console
     svc_soc_sim_uart #(
-        .CLOCK_FREQ (CLOCK_FREQ),
-        .BAUD_RATE  (BAUD_RATE),
-        .PRINT_RX   (1),           // Print app output to stdout
-        .PREFIX     (PREFIX),
-        .DISABLE_PTY(1)            // Don't create PTY - just use stdout
+        .CLOCK_FREQ   (CLOCK_FREQ),
+        .BAUD_RATE    (BAUD_RATE),
+        .PRINT_RX     (1),                 // Print app output to stdout
+        .PREFIX       (PREFIX),
+        .DISABLE_PTY  (1),                 // Don't create PTY - just use stdout
+        .STDIN_PLUSARG("APP_UART_STDIN"),
+        .RAW_STDIN    (1)
     ) app_console (
         .clk    (clk),
         .rst_n  (rst_n),
-        .urx_pin(),        // Not used - no input to app console
-        .utx_pin(uart_tx)  // Monitor app's UART TX
+        .urx_pin(app_console_rx),  // App's UART RX
+        .utx_pin(uart_tx)          // Monitor app's UART TX
     );
+
+    // Follow the app's runtime baud divisor
+    always @(posedge clk) begin
+      if (app_console.clk_div != io_regs.baud_div) begin
+        app_console.set_clk_div(io_regs.baud_div);
+      end
+    end
+  end else begin : gen_no_app_console
+    assign app_console_rx = 1'b1;
+  end
+
+  if (!DEBUG_ENABLED && !FAST_CONSOLE) begin : gen_term_baud
+    // The terminal talks to the app UART, so follow its runtime baud divisor
+    always @(posedge clk) begin
+      if (gen_uart_term.uart_terminal.clk_div != io_regs.baud_div) begin
+        gen_uart_term.uart_terminal.set_clk_div(io_regs.baud_div);
+      end
+    end
   end
 
   //
@@ -491,36 +628,163 @@ module svc_soc_sim #(
   //
   // I/O register bank with peripherals (UART, LED, GPIO)
   //
-  // In debug mode, the application UART RX is disabled (tied high/idle)
-  // since the UART is used by the debug bridge for loading.
+  // In debug mode, the UART is used by the debug bridge for loading, so the
+  // application UART RX comes from the app console (idle without
+  // +APP_UART_STDIN).
   //
   logic app_uart_rx;
-  assign app_uart_rx = DEBUG_ENABLED ? 1'b1 : uart_rx;
+  assign app_uart_rx = DEBUG_ENABLED ? app_console_rx : uart_rx;
+
+  //
+  // Stall attribution events for the io_reg counters
+  //
+  // Builds with SVC_SIM_PERF defined derive them in svc_soc_sim_perf from
+  // the CPU's RVFI retire port, so the core must also enable RVFI
+  // (RISCV_FORMAL), and in the cache SoC from the data cache AXI port.
+  // Otherwise, and for the single-cycle core, the counters read 0.
+  //
+  logic [6:0] perf_events;
+
+`ifdef SVC_SIM_PERF
+  logic        perf_retire_valid;
+  logic [31:0] perf_retire_insn;
+
+  if (MEM_TYPE == MEM_TYPE_SRAM) begin : gen_perf_sram
+    assign perf_retire_valid = sram_soc.rv_cpu.cpu.rvfi_valid;
+    assign perf_retire_insn  = sram_soc.rv_cpu.cpu.rvfi_insn;
+  end else if (MEM_TYPE == MEM_TYPE_BRAM_CACHE) begin : gen_perf_cache
+    assign perf_retire_valid = cache_soc.rv_cpu.cpu.rvfi_valid;
+    assign perf_retire_insn  = cache_soc.rv_cpu.cpu.rvfi_insn;
+  end else begin : gen_perf_bram
+    assign perf_retire_valid = bram_soc.rv_cpu.cpu.rvfi_valid;
+    assign perf_retire_insn  = bram_soc.rv_cpu.cpu.rvfi_insn;
+  end
+
+  if (PIPELINED) begin : gen_perf
+    if (MEM_TYPE == MEM_TYPE_BRAM_CACHE) begin : gen_perf_axi
+      svc_soc_sim_perf perf (
+          .clk          (clk),
+          .rst_n        (rst_n),
+          .retire_valid (perf_retire_valid),
+          .retire_insn  (perf_retire_insn),
+          .m_axi_arvalid(cache_soc.m_axi_arvalid),
+          .m_axi_arready(cache_soc.m_axi_arready),
+          .m_axi_rvalid (cache_soc.m_axi_rvalid),
+          .m_axi_rready (cache_soc.m_axi_rready),
+          .m_axi_rlast  (cache_soc.m_axi_rlast),
+          .m_axi_awvalid(cache_soc.m_axi_awvalid),
+          .m_axi_awready(cache_soc.m_axi_awready),
+          .m_axi_wvalid (cache_soc.m_axi_wvalid),
+          .m_axi_bvalid (cache_soc.m_axi_bvalid),
+          .m_axi_bready (cache_soc.m_axi_bready),
+          .perf_events  (perf_events)
+      );
+    end else begin : gen_perf_no_axi
+      svc_soc_sim_perf perf (
+          .clk          (clk),
+          .rst_n        (rst_n),
+          .retire_valid (perf_retire_valid),
+          .retire_insn  (perf_retire_insn),
+          .m_axi_arvalid(1'b0),
+          .m_axi_arready(1'b0),
+          .m_axi_rvalid (1'b0),
+          .m_axi_rready (1'b0),
+          .m_axi_rlast  (1'b0),
+          .m_axi_awvalid(1'b0),
+          .m_axi_awready(1'b0),
+          .m_axi_wvalid (1'b0),
+          .m_axi_bvalid (1'b0),
+          .m_axi_bready (1'b0),
+          .perf_events  (perf_events)
+      );
+    end
+  end else begin : gen_no_perf
+    assign perf_events = '0;
+  end
+`else
+  assign perf_events = '0;
+`endif
 
   svc_soc_io_reg #(
       .CLOCK_FREQ(CLOCK_FREQ),
       .BAUD_RATE (BAUD_RATE),
       .MEM_TYPE  (MEM_TYPE)
   ) io_regs (
-      .clk     (clk),
-      .rst_n   (rst_n),
-      .io_wen  (io_wen),
-      .io_waddr(io_waddr),
-      .io_wdata(io_wdata),
-      .io_wstrb(io_wstrb),
-      .io_ren  (io_ren),
-      .io_raddr(io_raddr),
-      .io_rdata(io_rdata),
-      .led     (led),
-      .gpio    (gpio),
-      .uart_tx (uart_tx),
-      .uart_rx (app_uart_rx)
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (led),
+      .gpio       (gpio),
+      .uart_tx    (uart_tx),
+      .uart_rx    (app_uart_rx),
+      .perf_events(perf_events)
   );
 
+  //
+  // Fast console
+  //
+  // Decodes console output from the CPU's stores to the UART TX data
+  // (0x00) and packed (0x1C, one byte per strobed lane) registers. Bytes
+  // pushed while the TX FIFO is full are dropped by the hardware but still
+  // printed here; libsvc waits for space, so that doesn't happen in
+  // practice.
+  //
+  if (FAST_CONSOLE) begin : gen_fast_console
+    string P;
+    bit    at_line_start;
+
+    function automatic void console_putc(input logic [7:0] c);
+      // Same filtering and prefixing as svc_soc_sim_uart
+      if (c == 8'h0A) begin
+        svc_sim_console_putc(int'(c));
+        at_line_start = 1;
+      end else if (c >= 8'h20 && c <= 8'h7E) begin
+        if (at_line_start) begin
+          for (int i = 0; i < P.len(); i++) begin
+            svc_sim_console_putc(int'(P[i]));
+          end
+          at_line_start = 0;
+        end
+        svc_sim_console_putc(int'(c));
+      end
+    endfunction
+
+    initial begin
+      if ($test$plusargs("SVC_SIM_PREFIX") && PREFIX != "") begin
+        P = $sformatf("%-8s", {PREFIX, ":"});
+      end else begin
+        P = "";
+      end
+      at_line_start = 1;
+    end
+
+    // verilator lint_off BLKSEQ
+    always @(posedge clk) begin
+      if (rst_n && io_wen) begin
+        if (io_waddr == 32'h80000000 && io_wstrb[0]) begin
+          console_putc(io_wdata[7:0]);
+        end else if (io_waddr == 32'h8000001C) begin
+          for (int i = 0; i < 4; i++) begin
+            if (io_wstrb[i]) begin
+              console_putc(io_wdata[8*i+:8]);
+            end
+          end
+        end
+      end
+    end
+    // verilator lint_on BLKSEQ
+  end
+
   //
   // Cycle counter (always enabled)
   //
-  int cycle_count;
+  longint cycle_count;
 
   always_ff @(posedge clk) begin
     if (!rst_n) begin
@@ -531,22 +795,318 @@ module svc_soc_sim #(
   end
 
   //
-  // Watchdog timer (optional)
+  // Memory report registers
+  //
+  // svc_mem_report() writes the measured stack and heap high-water marks
+  // to 0x80000040/0x44. svc_soc_io_reg ignores these addresses; the sim
+  // latches them and prints them with the end-of-run stats.
   //
-  logic timeout;
+  logic        mem_rpt_valid;
+  logic [31:0] mem_rpt_stack;
+  logic [31:0] mem_rpt_heap;
 
-  if (WATCHDOG_CYCLES > 0) begin : gen_watchdog
-    always_ff @(posedge clk) begin
-      if (!rst_n) begin
-        timeout <= 1'b0;
-      end else begin
-        if (cycle_count >= WATCHDOG_CYCLES) begin
-          timeout <= 1'b1;
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      mem_rpt_valid <= 1'b0;
+      mem_rpt_stack <= 32'h0;
+      mem_rpt_heap  <= 32'h0;
+    end else if (io_wen) begin
+      if (io_waddr == 32'h80000040) begin
+        mem_rpt_valid <= 1'b1;
+        mem_rpt_stack <= io_wdata;
+      end else if (io_waddr == 32'h80000044) begin
+        mem_rpt_heap <= io_wdata;
+      end
+    end
+  end
+
+  //
+  // Boot report register
+  //
+  // crt0.S writes 0x80000048 right before calling main. The cycle count at
+  // that write is the startup cost (.data/.bss init, stack canary paint),
+  // printed with the end-of-run stats so boot regressions show up.
+  //
+  logic boot_rpt_valid;
+  int   boot_cycles;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      boot_rpt_valid <= 1'b0;
+      boot_cycles    <= 0;
+    end else if (io_wen && io_waddr == 32'h80000048 && !boot_rpt_valid) begin
+      boot_rpt_valid <= 1'b1;
+      boot_cycles    <= int'(cycle_count);
+    end
+  end
+
+`ifdef SVC_SIM_CKPT
+  //
+  // Checkpoint/restore
+  //
+  // Software marks resumable points with SVC_CKPT() (libsvc/ckpt.h), which
+  // saves its registers into DMEM, drains the UART and writes 0x8000004C.
+  // With +SVC_CKPT_SAVE=<file>, the first such write at or after
+  // +SVC_CKPT_AT=<cycle> dumps DMEM to the file. +SVC_CKPT_LOAD=<file>
+  // loads a dump into DMEM while the CPU is held in reset; crt0 finds the
+  // saved state and resumes there. IMEM is not saved: restore with the
+  // same program image.
+  //
+  // The DMEM array is reached hierarchically through the SoC; override
+  // SVC_SIM_CKPT_DMEM if the memory instance is named differently. The
+  // cache SoC is not supported (dirty lines live in the D-cache).
+  //
+`ifndef SVC_SIM_CKPT_DMEM
+`define SVC_SIM_CKPT_DMEM rv_cpu.dmem.mem
+`endif
+
+  string  ckpt_save_path;
+  string  ckpt_load_path;
+  longint ckpt_at;
+  bit     ckpt_load;
+  bit     ckpt_saved;
+  logic   ckpt_take;
+
+  initial begin
+    ckpt_saved = 0;
+
+    if (!$value$plusargs("SVC_CKPT_SAVE=%s", ckpt_save_path)) begin
+      ckpt_save_path = "";
+    end
+    if (!$value$plusargs("SVC_CKPT_AT=%d", ckpt_at)) begin
+      ckpt_at = 0;
+    end
+    ckpt_load = $value$plusargs("SVC_CKPT_LOAD=%s", ckpt_load_path) != 0;
+  end
+
+  assign ckpt_take = (rst_n && io_wen && io_waddr == 32'h8000004C &&
+                      !ckpt_saved && ckpt_save_path != "" &&
+                      cycle_count >= ckpt_at);
+
+  //
+  // The restore waits for the first clock edge so it lands after the
+  // memories' own $readmemh at time 0, while the CPU is still in reset
+  //
+  if (MEM_TYPE == MEM_TYPE_SRAM) begin : gen_ckpt_sram
+    initial begin
+      @(posedge clk);
+      if (ckpt_load) begin
+        $readmemh(ckpt_load_path, sram_soc.`SVC_SIM_CKPT_DMEM);
+        $display("SVC_SOC_SIM: restored checkpoint %s", ckpt_load_path);
+      end
+    end
+
+    always @(posedge clk) begin
+      if (ckpt_take) begin
+        $writememh(ckpt_save_path, sram_soc.`SVC_SIM_CKPT_DMEM);
+        ckpt_saved = 1;
+        $display("SVC_SOC_SIM: checkpoint at cycle %0d -> %s", cycle_count,
+                 ckpt_save_path);
+      end
+    end
+  end else if (MEM_TYPE == MEM_TYPE_BRAM) begin : gen_ckpt_bram
+    initial begin
+      @(posedge clk);
+      if (ckpt_load) begin
+        $readmemh(ckpt_load_path, bram_soc.`SVC_SIM_CKPT_DMEM);
+        $display("SVC_SOC_SIM: restored checkpoint %s", ckpt_load_path);
+      end
+    end
+
+    always @(posedge clk) begin
+      if (ckpt_take) begin
+        $writememh(ckpt_save_path, bram_soc.`SVC_SIM_CKPT_DMEM);
+        ckpt_saved = 1;
+        $display("SVC_SOC_SIM: checkpoint at cycle %0d -> %s", cycle_count,
+                 ckpt_save_path);
+      end
+    end
+  end else begin : gen_ckpt_none
+    initial begin
+      if (ckpt_load || ckpt_save_path != "") begin
+        $fatal(1, "SVC_SOC_SIM: checkpoints need MEM_TYPE BRAM or SRAM");
+      end
+    end
+  end
+`endif
+
+`ifdef SVC_SIM_PROF
+  //
+  // Sampling PC profiler
+  //
+  // Taps the CPU's RVFI retire port, so the profiling build must also
+  // enable RVFI in the core (RISCV_FORMAL).
+  //
+  logic        prof_retire_valid;
+  logic [31:0] prof_retire_pc;
+
+  if (MEM_TYPE == MEM_TYPE_SRAM) begin : gen_prof_sram
+    assign prof_retire_valid = sram_soc.rv_cpu.cpu.rvfi_valid;
+    assign prof_retire_pc    = sram_soc.rv_cpu.cpu.rvfi_pc_rdata;
+  end else if (MEM_TYPE == MEM_TYPE_BRAM_CACHE) begin : gen_prof_cache
+    assign prof_retire_valid = cache_soc.rv_cpu.cpu.rvfi_valid;
+    assign prof_retire_pc    = cache_soc.rv_cpu.cpu.rvfi_pc_rdata;
+  end else begin : gen_prof_bram
+    assign prof_retire_valid = bram_soc.rv_cpu.cpu.rvfi_valid;
+    assign prof_retire_pc    = bram_soc.rv_cpu.cpu.rvfi_pc_rdata;
+  end
+
+  svc_soc_sim_prof prof (
+      .clk         (clk),
+      .rst_n       (rst_n),
+      .retire_valid(prof_retire_valid),
+      .retire_pc   (prof_retire_pc)
+  );
+`endif
+
+`ifdef SVC_SIM_ISS
+  //
+  // ISS co-simulation
+  //
+  // Lockstep taps the CPU's RVFI retire port, so the build must also
+  // enable RVFI in the core (RISCV_FORMAL). Fast-forward runs the model on
+  // the first clock edge, while the CPU is still in reset, then overwrites
+  // DMEM with the model's and IMEM with the handoff stub image (see
+  // svc_soc_sim_iss.cpp). The memory arrays are reached hierarchically
+  // like the checkpoint code; override SVC_SIM_ISS_IMEM/SVC_SIM_ISS_DMEM
+  // if they are named differently. The cache SoC supports lockstep only.
+  //
+`ifndef SVC_SIM_ISS_IMEM
+`define SVC_SIM_ISS_IMEM rv_cpu.imem.mem
+`endif
+`ifndef SVC_SIM_ISS_DMEM
+`define SVC_SIM_ISS_DMEM rv_cpu.dmem.mem
+`endif
+
+  logic        iss_retire_valid;
+  logic [31:0] iss_retire_pc;
+  logic [31:0] iss_retire_insn;
+  logic [ 4:0] iss_retire_rd_addr;
+  logic [31:0] iss_retire_rd_wdata;
+
+  if (MEM_TYPE == MEM_TYPE_SRAM) begin : gen_iss_sram
+    assign iss_retire_valid    = sram_soc.rv_cpu.cpu.rvfi_valid;
+    assign iss_retire_pc       = sram_soc.rv_cpu.cpu.rvfi_pc_rdata;
+    assign iss_retire_insn     = sram_soc.rv_cpu.cpu.rvfi_insn;
+    assign iss_retire_rd_addr  = sram_soc.rv_cpu.cpu.rvfi_rd_addr;
+    assign iss_retire_rd_wdata = sram_soc.rv_cpu.cpu.rvfi_rd_wdata;
+  end else if (MEM_TYPE == MEM_TYPE_BRAM_CACHE) begin : gen_iss_cache
+    assign iss_retire_valid    = cache_soc.rv_cpu.cpu.rvfi_valid;
+    assign iss_retire_pc       = cache_soc.rv_cpu.cpu.rvfi_pc_rdata;
+    assign iss_retire_insn     = cache_soc.rv_cpu.cpu.rvfi_insn;
+    assign iss_retire_rd_addr  = cache_soc.rv_cpu.cpu.rvfi_rd_addr;
+    assign iss_retire_rd_wdata = cache_soc.rv_cpu.cpu.rvfi_rd_wdata;
+  end else begin : gen_iss_bram
+    assign iss_retire_valid    = bram_soc.rv_cpu.cpu.rvfi_valid;
+    assign iss_retire_pc       = bram_soc.rv_cpu.cpu.rvfi_pc_rdata;
+    assign iss_retire_insn     = bram_soc.rv_cpu.cpu.rvfi_insn;
+    assign iss_retire_rd_addr  = bram_soc.rv_cpu.cpu.rvfi_rd_addr;
+    assign iss_retire_rd_wdata = bram_soc.rv_cpu.cpu.rvfi_rd_wdata;
+  end
+
+  svc_soc_sim_iss #(
+      .IMEM_INIT (IMEM_INIT),
+      .DMEM_INIT (DMEM_INIT),
+      .IMEM_DEPTH(IMEM_DEPTH),
+      .DMEM_DEPTH(DMEM_DEPTH),
+      .EXT_ZMMUL (EXT_ZMMUL),
+      .EXT_M     (EXT_M),
+      .CLOCK_FREQ(CLOCK_FREQ),
+      .BAUD_RATE (BAUD_RATE)
+  ) iss (
+      .clk            (clk),
+      .rst_n          (rst_n),
+      .retire_valid   (iss_retire_valid),
+      .retire_pc      (iss_retire_pc),
+      .retire_insn    (iss_retire_insn),
+      .retire_rd_addr (iss_retire_rd_addr),
+      .retire_rd_wdata(iss_retire_rd_wdata)
+  );
+
+  //
+  // Run the model and build the handoff images. ok is 0 when there is
+  // nothing to hand off.
+  //
+  task automatic iss_fast_forward(output bit ok);
+    int status;
+
+    ok     = 0;
+    status = svc_iss_run(iss.ff_instrs);
+
+    if (status == SVC_ISS_HALTED) begin
+      $display("SVC_SOC_SIM: ebreak during fast-forward, after %0d instrs",
+               svc_iss_instret());
+      $finish(0);
+    end else if (status == SVC_ISS_ERROR || svc_iss_handoff() != 0) begin
+      $fatal(1, "SVC_SOC_SIM: fast-forward failed");
+    end else begin
+      ok = 1;
+    end
+  endtask
+
+  if (MEM_TYPE == MEM_TYPE_SRAM) begin : gen_iss_ff_sram
+    initial begin
+      bit ok;
+
+      @(posedge clk);
+      if (iss.ff_instrs != 0) begin
+        iss_fast_forward(ok);
+        for (int i = 0; ok && i < IMEM_DEPTH; i++) begin
+          sram_soc.`SVC_SIM_ISS_IMEM[i] = svc_iss_imem_word(i);
+        end
+        for (int i = 0; ok && i < DMEM_DEPTH; i++) begin
+          sram_soc.`SVC_SIM_ISS_DMEM[i] = svc_iss_dmem_word(i);
+        end
+      end
+    end
+  end else if (MEM_TYPE == MEM_TYPE_BRAM) begin : gen_iss_ff_bram
+    initial begin
+      bit ok;
+
+      @(posedge clk);
+      if (iss.ff_instrs != 0) begin
+        iss_fast_forward(ok);
+        for (int i = 0; ok && i < IMEM_DEPTH; i++) begin
+          bram_soc.`SVC_SIM_ISS_IMEM[i] = svc_iss_imem_word(i);
+        end
+        for (int i = 0; ok && i < DMEM_DEPTH; i++) begin
+          bram_soc.`SVC_SIM_ISS_DMEM[i] = svc_iss_dmem_word(i);
         end
       end
     end
-  end else begin : gen_no_watchdog
-    assign timeout = 1'b0;
+  end else begin : gen_iss_ff_none
+    initial begin
+      @(posedge clk);
+      if (iss.ff_instrs != 0) begin
+        $fatal(1, "SVC_SOC_SIM: fast-forward needs MEM_TYPE BRAM or SRAM");
+      end
+    end
+  end
+`endif
+
+  //
+  // Watchdog timer (optional)
+  //
+  // WATCHDOG_CYCLES is the program's default; +SVC_SIM_WATCHDOG=<cycles>
+  // overrides it at run time (0 disables).
+  //
+  logic   timeout;
+  longint watchdog_cycles;
+
+  initial begin
+    if (!$value$plusargs("SVC_SIM_WATCHDOG=%d", watchdog_cycles)) begin
+      watchdog_cycles = WATCHDOG_CYCLES;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      timeout <= 1'b0;
+    end else begin
+      if (watchdog_cycles > 0 && cycle_count >= watchdog_cycles) begin
+        timeout <= 1'b1;
+      end
+    end
   end
 
   //
@@ -555,6 +1115,8 @@ module svc_soc_sim #(
   initial begin
     string  sep;
     string  P;
+    string  dmem_image;
+    integer dmem_fd;
     integer sim_prefix_enabled;
 
     $display("SVC_SOC_SIM: Starting...");
@@ -562,6 +1124,17 @@ module svc_soc_sim #(
     $display("SVC_SOC_SIM: DMEM_INIT=%s", DMEM_INIT);
     $fflush();
 
+    // A missing DMEM image would leave DMEM empty instead of failing, so
+    // stop here (the cache build reads the 128-bit image)
+    dmem_image = (MEM_TYPE == MEM_TYPE_BRAM_CACHE) ? DMEM_INIT_128 : DMEM_INIT;
+    if (dmem_image != "") begin
+      dmem_fd = $fopen(dmem_image, "r");
+      if (dmem_fd == 0) begin
+        $fatal(1, "SVC_SOC_SIM: DMEM image %s not found", dmem_image);
+      end
+      $fclose(dmem_fd);
+    end
+
     done = 0;
 
     // Wait for reset to complete
@@ -587,7 +1160,7 @@ module svc_soc_sim #(
       $display("%smain:        %s", P, SW_PATH);
     end
 
-    $display("%swatchdog:    %0d cycles", P, WATCHDOG_CYCLES);
+    $display("%swatchdog:    %0d cycles", P, watchdog_cycles);
 
     $display(
         "%smem type:    %s", P,
@@ -650,6 +1223,9 @@ module svc_soc_sim #(
     wait (timeout || ebreak);
 
     // End of simulation output
+`ifdef SVC_SIM_FAST
+    svc_sim_console_flush();
+`endif
     $display("%s%s", P, sep);
 
     $display("SVC_SOC_SIM: Complete!");
@@ -663,6 +1239,16 @@ module svc_soc_sim #(
 
     $display("%scycles: %0d", P, cycle_count);
 
+    if (boot_rpt_valid) begin
+      $display("%sboot:   %0d cycles (to main)", P, boot_cycles);
+    end
+
+    if (mem_rpt_valid) begin
+      $display("%sdmem:   %0d bytes", P, DMEM_DEPTH * 4);
+      $display("%sstack:  %0d bytes (high-water)", P, mem_rpt_stack);
+      $display("%sheap:   %0d bytes (high-water)", P, mem_rpt_heap);
+    end
+
 `ifndef VERILATOR
     if (PIPELINED == 1) begin : g_cpi_rpt
       //
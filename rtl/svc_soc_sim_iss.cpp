@@ -0,0 +1,649 @@
+//
+// RV32I/M instruction-set simulator for SoC simulations (SVC_SIM_ISS)
+//
+// A small reference model svc_soc_sim drives through DPI (see
+// svc_soc_sim_iss.sv):
+//
+// - Lockstep: every instruction the RTL retires is stepped here too, and
+//   the retired PC, instruction word and register write are compared.
+//   Values the model can't know (I/O loads, counter CSRs) are taken from
+//   the RTL's register write, so they never count as a divergence.
+// - Fast-forward: runs the start of a program at native speed, with the
+//   UART TX registers going to the console and the status registers
+//   always ready, then hands its registers, PC and DMEM to the RTL.
+//
+// Memories load from the same IMEM/DMEM hex images as the RTL ($readmemh
+// format, one 32-bit word per line), so the model and the RTL run the
+// exact same program.
+//
+// Handoff: registers and PC reach the RTL through a stub written into the
+// top of IMEM (lui/addi per register, then a jal to the PC), entered from
+// a jal patched over the reset vector. The RTL runs from reset into the
+// stub, so nothing in the core itself needs to be reachable from the sim.
+//
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// I/O space (svc_soc_io_reg)
+constexpr uint32_t IO_BASE       = 0x80000000;
+constexpr uint32_t IO_UART_TX    = 0x00;
+constexpr uint32_t IO_UART_STAT  = 0x04;
+constexpr uint32_t IO_CLOCK_FREQ = 0x10;
+constexpr uint32_t IO_UART_PACK  = 0x1C;
+constexpr uint32_t IO_BAUD_DIV   = 0x20;
+
+// TX ready, TX idle, 16 free FIFO entries
+constexpr uint32_t UART_STAT_IDLE = 0x1003;
+
+// Instructions
+constexpr uint32_t INSN_EBREAK = 0x00100073;
+constexpr uint32_t INSN_ECALL  = 0x00000073;
+
+constexpr int HISTORY = 8;
+
+enum Status { ISS_OK = 0, ISS_HALT = 1, ISS_ERROR = 2 };
+
+struct Iss {
+  std::vector<uint32_t> imem;
+  std::vector<uint32_t> dmem;
+
+  uint32_t x[32];
+  uint32_t pc;
+  uint64_t instret;
+  int      status;
+  char     error[128];
+
+  // 0: RV32I, 1: Zmmul, 2: M
+  int      ext_m;
+  uint32_t clock_freq;
+  uint32_t baud_div;
+
+  // Register write of the last instruction (rd 0: none)
+  uint32_t rd;
+  uint32_t rd_val;
+
+  // Recently executed PCs, for divergence reports
+  uint32_t history[HISTORY];
+  uint64_t checked;
+
+  // Handoff stub, entered from a jal patched over IMEM word 0
+  std::vector<uint32_t> stub;
+  uint32_t              stub_base;
+  uint32_t              reset_jump;
+  bool                  patched;
+  bool                  syncing;
+};
+
+Iss iss;
+
+bool load_hex(const char *path, std::vector<uint32_t> &mem) {
+  if (path == nullptr || path[0] == '\0') {
+    return true;
+  }
+
+  FILE *f = std::fopen(path, "r");
+  if (f == nullptr) {
+    std::printf("SVC_SOC_SIM_ISS: cannot open %s\n", path);
+    return false;
+  }
+
+  char   line[64];
+  size_t i = 0;
+  while (std::fgets(line, sizeof(line), f) != nullptr) {
+    if (line[0] == '\n' || line[0] == '/' || line[0] == '@') {
+      continue;
+    }
+    if (i == mem.size()) {
+      std::printf("SVC_SOC_SIM_ISS: %s is larger than the memory\n", path);
+      std::fclose(f);
+      return false;
+    }
+    mem[i++] = (uint32_t)std::strtoul(line, nullptr, 16);
+  }
+
+  std::fclose(f);
+  return true;
+}
+
+int fail(const char *msg, uint32_t addr) {
+  std::snprintf(iss.error, sizeof(iss.error), "%s (0x%08x)", msg, addr);
+  iss.status = ISS_ERROR;
+  return ISS_ERROR;
+}
+
+void console_putc(uint32_t c) {
+  std::putchar((int)c);
+  if (c == '\n') {
+    std::fflush(stdout);
+  }
+}
+
+//
+// I/O models for fast-forward
+//
+uint32_t io_read(uint32_t off) {
+  switch (off) {
+  case IO_UART_STAT:
+    return UART_STAT_IDLE;
+  case IO_CLOCK_FREQ:
+    return iss.clock_freq;
+  case IO_BAUD_DIV:
+    return iss.baud_div;
+  default:
+    return 0;
+  }
+}
+
+void io_write(uint32_t off, uint32_t data, uint32_t strb, bool console) {
+  if (off == IO_UART_TX && (strb & 1) && console) {
+    console_putc(data & 0xFF);
+  } else if (off == IO_UART_PACK && console) {
+    for (int i = 0; i < 4; i++) {
+      if (strb & (1u << i)) {
+        console_putc((data >> (8 * i)) & 0xFF);
+      }
+    }
+  } else if (off == IO_BAUD_DIV && (strb & 3) == 3) {
+    if ((data & 0xFFFF) >= 4) {
+      iss.baud_div = data & 0xFFFF;
+    }
+  }
+}
+
+//
+// Counter CSRs (cycle, time and instret read the same in the model)
+//
+uint32_t csr_read(uint32_t csr) {
+  switch (csr) {
+  case 0xC00:
+  case 0xC01:
+  case 0xC02:
+  case 0xB00:
+  case 0xB02:
+    return (uint32_t)iss.instret;
+  case 0xC80:
+  case 0xC81:
+  case 0xC82:
+  case 0xB80:
+  case 0xB82:
+    return (uint32_t)(iss.instret >> 32);
+  default:
+    return 0;
+  }
+}
+
+uint32_t sx(uint32_t v, int bits) {
+  return (uint32_t)((int32_t)(v << (32 - bits)) >> (32 - bits));
+}
+
+//
+// Execute one instruction
+//
+// rtl_rd_wdata, when given, is the RTL's register write for the same
+// instruction: it supplies I/O load and CSR read results. Without it the
+// I/O models above stand in, and console output is printed.
+//
+int step(const uint32_t *rtl_rd_wdata) {
+  uint32_t pc = iss.pc;
+
+  if ((pc & 3) != 0 || (pc >> 2) >= iss.imem.size()) {
+    return fail("fetch outside IMEM", pc);
+  }
+
+  uint32_t insn    = iss.imem[pc >> 2];
+  uint32_t opcode  = insn & 0x7F;
+  uint32_t rd      = (insn >> 7) & 0x1F;
+  uint32_t funct3  = (insn >> 12) & 0x7;
+  uint32_t rs1     = (insn >> 15) & 0x1F;
+  uint32_t rs2     = (insn >> 20) & 0x1F;
+  uint32_t funct7  = insn >> 25;
+  uint32_t a       = iss.x[rs1];
+  uint32_t b       = iss.x[rs2];
+  uint32_t imm_i   = sx(insn >> 20, 12);
+  uint32_t imm_s   = sx(((insn >> 20) & 0xFE0) | rd, 12);
+  uint32_t next_pc = pc + 4;
+  bool     wr      = true;
+  uint32_t val     = 0;
+
+  switch (opcode) {
+  case 0x37:  // lui
+    val = insn & 0xFFFFF000;
+    break;
+
+  case 0x17:  // auipc
+    val = pc + (insn & 0xFFFFF000);
+    break;
+
+  case 0x6F: {  // jal
+    uint32_t imm = sx(((insn >> 11) & 0x100000) | (insn & 0xFF000) |
+                          ((insn >> 9) & 0x800) | ((insn >> 20) & 0x7FE),
+                      21);
+    val          = next_pc;
+    next_pc      = pc + imm;
+    break;
+  }
+
+  case 0x67:  // jalr
+    if (funct3 != 0) {
+      return fail("illegal instruction", insn);
+    }
+    val     = next_pc;
+    next_pc = (a + imm_i) & ~1u;
+    break;
+
+  case 0x63: {  // branches
+    uint32_t imm = sx(((insn >> 19) & 0x1000) | ((insn << 4) & 0x800) |
+                          ((insn >> 20) & 0x7E0) | ((insn >> 7) & 0x1E),
+                      13);
+    bool     taken;
+
+    switch (funct3) {
+    case 0: taken = a == b; break;
+    case 1: taken = a != b; break;
+    case 4: taken = (int32_t)a < (int32_t)b; break;
+    case 5: taken = (int32_t)a >= (int32_t)b; break;
+    case 6: taken = a < b; break;
+    case 7: taken = a >= b; break;
+    default: return fail("illegal instruction", insn);
+    }
+
+    wr = false;
+    if (taken) {
+      next_pc = pc + imm;
+    }
+    break;
+  }
+
+  case 0x03: {  // loads
+    uint32_t addr  = a + imm_i;
+    uint32_t size  = funct3 & 3;
+    uint32_t shift = 8 * (addr & 3);
+
+    if (size == 3 || funct3 > 5) {
+      return fail("illegal instruction", insn);
+    }
+    if ((addr & ((1u << size) - 1)) != 0) {
+      return fail("misaligned load", addr);
+    }
+
+    if (addr >= IO_BASE && rtl_rd_wdata != nullptr) {
+      val = *rtl_rd_wdata;
+      break;
+    }
+
+    uint32_t word;
+    if (addr >= IO_BASE) {
+      word = io_read((addr - IO_BASE) & ~3u);
+    } else if ((addr >> 2) < iss.dmem.size()) {
+      word = iss.dmem[addr >> 2];
+    } else {
+      return fail("load outside DMEM", addr);
+    }
+
+    word >>= shift;
+    switch (funct3) {
+    case 0: val = sx(word, 8); break;
+    case 1: val = sx(word, 16); break;
+    case 2: val = word; break;
+    case 4: val = word & 0xFF; break;
+    case 5: val = word & 0xFFFF; break;
+    }
+    break;
+  }
+
+  case 0x23: {  // stores
+    uint32_t addr = a + imm_s;
+    uint32_t mask = funct3 == 0 ? 0x1 : funct3 == 1 ? 0x3 : 0xF;
+
+    if (funct3 > 2) {
+      return fail("illegal instruction", insn);
+    }
+    if ((addr & ((1u << funct3) - 1)) != 0) {
+      return fail("misaligned store", addr);
+    }
+
+    uint32_t strb = mask << (addr & 3);
+    uint32_t data = b << (8 * (addr & 3));
+
+    wr = false;
+    if (addr >= IO_BASE) {
+      io_write((addr - IO_BASE) & ~3u, data, strb, rtl_rd_wdata == nullptr);
+    } else if ((addr >> 2) < iss.dmem.size()) {
+      uint32_t bits = 0;
+      for (int i = 0; i < 4; i++) {
+        if (strb & (1u << i)) {
+          bits |= 0xFFu << (8 * i);
+        }
+      }
+      uint32_t &w = iss.dmem[addr >> 2];
+      w           = (w & ~bits) | (data & bits);
+    } else {
+      return fail("store outside DMEM", addr);
+    }
+    break;
+  }
+
+  case 0x13: {  // immediate ALU ops
+    uint32_t shamt = rs2;
+
+    switch (funct3) {
+    case 0: val = a + imm_i; break;
+    case 2: val = (int32_t)a < (int32_t)imm_i; break;
+    case 3: val = a < imm_i; break;
+    case 4: val = a ^ imm_i; break;
+    case 6: val = a | imm_i; break;
+    case 7: val = a & imm_i; break;
+    case 1:
+      if (funct7 != 0) {
+        return fail("illegal instruction", insn);
+      }
+      val = a << shamt;
+      break;
+    case 5:
+      if (funct7 == 0) {
+        val = a >> shamt;
+      } else if (funct7 == 0x20) {
+        val = (uint32_t)((int32_t)a >> shamt);
+      } else {
+        return fail("illegal instruction", insn);
+      }
+      break;
+    }
+    break;
+  }
+
+  case 0x33:  // register ALU ops
+    if (funct7 == 0x01) {
+      int64_t  sa = (int32_t)a;
+      int64_t  sb = (int32_t)b;
+      uint64_t ua = a;
+      uint64_t ub = b;
+
+      if (iss.ext_m == 0 || (iss.ext_m == 1 && funct3 >= 4)) {
+        return fail("M instruction without the extension", insn);
+      }
+
+      switch (funct3) {
+      case 0: val = a * b; break;
+      case 1: val = (uint32_t)((uint64_t)(sa * sb) >> 32); break;
+      case 2: val = (uint32_t)((uint64_t)(sa * (int64_t)ub) >> 32); break;
+      case 3: val = (uint32_t)((ua * ub) >> 32); break;
+      case 4:
+        val = b == 0                             ? 0xFFFFFFFF
+              : (a == 0x80000000 && b == ~0u) ? a
+                                                 : (uint32_t)((int32_t)a / (int32_t)b);
+        break;
+      case 5: val = b == 0 ? 0xFFFFFFFF : a / b; break;
+      case 6:
+        val = b == 0                             ? a
+              : (a == 0x80000000 && b == ~0u) ? 0
+                                                 : (uint32_t)((int32_t)a % (int32_t)b);
+        break;
+      case 7: val = b == 0 ? a : a % b; break;
+      }
+      break;
+    }
+
+    if (funct7 != 0 && !(funct7 == 0x20 && (funct3 == 0 || funct3 == 5))) {
+      return fail("illegal instruction", insn);
+    }
+
+    switch (funct3) {
+    case 0: val = funct7 ? a - b : a + b; break;
+    case 1: val = a << (b & 0x1F); break;
+    case 2: val = (int32_t)a < (int32_t)b; break;
+    case 3: val = a < b; break;
+    case 4: val = a ^ b; break;
+    case 5:
+      val = funct7 ? (uint32_t)((int32_t)a >> (b & 0x1F)) : a >> (b & 0x1F);
+      break;
+    case 6: val = a | b; break;
+    case 7: val = a & b; break;
+    }
+    break;
+
+  case 0x0F:  // fence, fence.i
+    wr = false;
+    break;
+
+  case 0x73:  // system
+    if (insn == INSN_EBREAK) {
+      iss.status = ISS_HALT;
+      wr         = false;
+      next_pc    = pc;
+      break;
+    }
+    if (insn == INSN_ECALL || funct3 == 0 || funct3 == 4) {
+      return fail("unsupported system instruction", insn);
+    }
+
+    // Counters are read-only here: writes are ignored, reads come from
+    // the RTL when it is running alongside
+    val = rtl_rd_wdata != nullptr ? *rtl_rd_wdata : csr_read(insn >> 20);
+    break;
+
+  default:
+    return fail("illegal instruction", insn);
+  }
+
+  iss.rd     = wr ? rd : 0;
+  iss.rd_val = iss.rd != 0 ? val : 0;
+  if (iss.rd != 0) {
+    iss.x[rd] = val;
+  }
+
+  iss.history[iss.instret % HISTORY] = pc;
+  iss.pc                             = next_pc;
+  iss.instret++;
+
+  return iss.status;
+}
+
+uint32_t enc_lui(uint32_t rd, uint32_t hi) {
+  return (hi << 12) | (rd << 7) | 0x37;
+}
+
+uint32_t enc_addi(uint32_t rd, uint32_t rs1, uint32_t imm) {
+  return ((imm & 0xFFF) << 20) | (rs1 << 15) | (rd << 7) | 0x13;
+}
+
+uint32_t enc_jal(uint32_t from, uint32_t to) {
+  uint32_t off = to - from;
+
+  return (((off >> 20) & 1) << 31) | (((off >> 1) & 0x3FF) << 21) |
+         (((off >> 11) & 1) << 20) | (((off >> 12) & 0xFF) << 12) | 0x6F;
+}
+
+void print_history() {
+  uint64_t n = iss.instret < HISTORY ? iss.instret : HISTORY;
+
+  std::printf("SVC_SOC_SIM_ISS: last %" PRIu64 " ISS PCs:", n);
+  for (uint64_t i = iss.instret - n; i < iss.instret; i++) {
+    std::printf(" %08x", iss.history[i % HISTORY]);
+  }
+  std::printf("\n");
+}
+
+}  // namespace
+
+extern "C" {
+
+//
+// Load the program images and reset the model
+//
+// ext_m: 0 RV32I, 1 Zmmul, 2 M. Returns 0, or -1 if an image can't be
+// loaded.
+//
+int svc_iss_init(const char *imem_hex, const char *dmem_hex, int imem_depth,
+                 int dmem_depth, int ext_m, int clock_freq, int baud_rate) {
+  iss = Iss();
+  iss.imem.assign((size_t)imem_depth, 0);
+  iss.dmem.assign((size_t)dmem_depth, 0);
+  iss.ext_m      = ext_m;
+  iss.clock_freq = (uint32_t)clock_freq;
+  iss.baud_div   = (uint32_t)(clock_freq / baud_rate);
+
+  if (!load_hex(imem_hex, iss.imem) || !load_hex(dmem_hex, iss.dmem)) {
+    return -1;
+  }
+
+  return 0;
+}
+
+//
+// Fast-forward up to n instructions, printing UART output
+//
+// Returns the status: 0 still running, 1 halted on ebreak, 2 error.
+//
+int svc_iss_run(long long n) {
+  for (long long i = 0; i < n && iss.status == ISS_OK; i++) {
+    step(nullptr);
+  }
+
+  std::fflush(stdout);
+  if (iss.status == ISS_ERROR) {
+    std::printf("SVC_SOC_SIM_ISS: %s at pc %08x\n", iss.error, iss.pc);
+    print_history();
+  }
+
+  return iss.status;
+}
+
+long long svc_iss_instret() {
+  return (long long)iss.instret;
+}
+
+//
+// Build the handoff stub and patch the reset vector
+//
+// Afterwards svc_iss_imem_word()/svc_iss_dmem_word() give the images to
+// write into the RTL memories. Returns 0, or -1 if the top of IMEM is in
+// use or the stub can't reach the PC.
+//
+int svc_iss_handoff() {
+  std::vector<uint32_t> &s = iss.stub;
+
+  s.clear();
+  for (uint32_t r = 1; r < 32; r++) {
+    uint32_t v  = iss.x[r];
+    uint32_t hi = (v + 0x800) >> 12;
+    uint32_t lo = v & 0xFFF;
+
+    if (hi != 0) {
+      s.push_back(enc_lui(r, hi & 0xFFFFF));
+      s.push_back(enc_addi(r, r, lo));
+    } else {
+      s.push_back(enc_addi(r, 0, lo));
+    }
+  }
+  s.push_back(0);  // jal, once the base is known
+
+  iss.stub_base = (uint32_t)(iss.imem.size() - s.size());
+  for (size_t i = iss.stub_base; i < iss.imem.size(); i++) {
+    if (iss.imem[i] != 0) {
+      std::printf("SVC_SOC_SIM_ISS: no room for the handoff stub: IMEM "
+                  "word %zu is in use\n",
+                  i);
+      return -1;
+    }
+  }
+
+  uint32_t jump_pc = 4 * (iss.stub_base + (uint32_t)s.size() - 1);
+  int32_t  reach   = (int32_t)(iss.pc - jump_pc);
+  if (reach < -(1 << 20) || reach >= (1 << 20)) {
+    std::printf("SVC_SOC_SIM_ISS: pc %08x out of jal range\n", iss.pc);
+    return -1;
+  }
+
+  s.back()       = enc_jal(jump_pc, iss.pc);
+  iss.reset_jump = enc_jal(0, 4 * iss.stub_base);
+  iss.patched    = true;
+  iss.syncing    = true;
+
+  std::printf("SVC_SOC_SIM_ISS: handoff after %" PRIu64 " instrs at pc "
+              "%08x\n",
+              iss.instret, iss.pc);
+  std::fflush(stdout);
+
+  return 0;
+}
+
+uint32_t svc_iss_imem_word(int i) {
+  size_t w = (size_t)i;
+
+  if (iss.patched && w == 0) {
+    return iss.reset_jump;
+  }
+  if (iss.patched && w >= iss.stub_base) {
+    return iss.stub[w - iss.stub_base];
+  }
+  return w < iss.imem.size() ? iss.imem[w] : 0;
+}
+
+uint32_t svc_iss_dmem_word(int i) {
+  return (size_t)i < iss.dmem.size() ? iss.dmem[(size_t)i] : 0;
+}
+
+//
+// Lockstep: step the model for one RTL retire and compare
+//
+// rd_addr is 0 when the instruction writes no register. Returns 0 if the
+// retire matches, else prints the divergence and returns 1.
+//
+int svc_iss_check(uint32_t pc, uint32_t insn, int rd_addr,
+                  uint32_t rd_wdata) {
+  // The handoff stub runs on the RTL only; the model resumes after its
+  // final jal
+  if (iss.syncing) {
+    if (pc == 4 * (iss.stub_base + (uint32_t)iss.stub.size() - 1)) {
+      iss.syncing = false;
+    }
+    return 0;
+  }
+
+  uint64_t n        = iss.instret;
+  uint32_t iss_pc   = iss.pc;
+  uint32_t iss_insn = (iss_pc >> 2) < iss.imem.size() ? iss.imem[iss_pc >> 2] : 0;
+  const char *what  = nullptr;
+
+  if (iss.status == ISS_HALT) {
+    what = "RTL retired past ebreak";
+  } else if (pc != iss_pc) {
+    what = "pc";
+  } else if (insn != iss_insn) {
+    what = "instruction";
+  } else if (step(&rd_wdata) == ISS_ERROR) {
+    what = iss.error;
+  } else if ((uint32_t)rd_addr != iss.rd ||
+             (iss.rd != 0 && rd_wdata != iss.rd_val)) {
+    what = "register write";
+  }
+
+  if (what == nullptr) {
+    iss.checked++;
+    return 0;
+  }
+
+  std::fflush(stdout);
+  std::printf("SVC_SOC_SIM_ISS: divergence at instr %" PRIu64 ": %s\n", n,
+              what);
+  std::printf("SVC_SOC_SIM_ISS:   rtl pc %08x insn %08x x%-2d = %08x\n", pc,
+              insn, rd_addr, rd_wdata);
+  std::printf("SVC_SOC_SIM_ISS:   iss pc %08x insn %08x x%-2u = %08x\n",
+              iss_pc, iss_insn, iss.rd, iss.rd_val);
+  print_history();
+  std::fflush(stdout);
+
+  return 1;
+}
+
+long long svc_iss_checked() {
+  return (long long)iss.checked;
+}
+
+}  // extern "C"
@@ -0,0 +1,124 @@
+`ifndef SVC_SOC_SIM_ISS_SV
+`define SVC_SOC_SIM_ISS_SV
+
+`include "svc.sv"
+
+//
+// Reference model (rtl/svc_soc_sim_iss.cpp)
+//
+import "DPI-C" function int svc_iss_init(
+  input string imem_hex,
+  input string dmem_hex,
+  input int    imem_depth,
+  input int    dmem_depth,
+  input int    ext_m,
+  input int    clock_freq,
+  input int    baud_rate
+);
+import "DPI-C" function int svc_iss_run(input longint n);
+import "DPI-C" function longint svc_iss_instret();
+import "DPI-C" function int svc_iss_handoff();
+import "DPI-C" function int unsigned svc_iss_imem_word(input int i);
+import "DPI-C" function int unsigned svc_iss_dmem_word(input int i);
+import "DPI-C" function int svc_iss_check(
+  input int unsigned pc,
+  input int unsigned insn,
+  input int          rd_addr,
+  input int unsigned rd_wdata
+);
+import "DPI-C" function longint svc_iss_checked();
+
+// ISS run status (svc_iss_run)
+localparam int SVC_ISS_RUNNING = 0;
+localparam int SVC_ISS_HALTED = 1;
+localparam int SVC_ISS_ERROR = 2;
+
+// Instructions per unit of +SVC_ISS_FF
+localparam longint SVC_ISS_FF_UNIT = 1_000_000;
+
+// RV32I/M instruction-set simulator co-simulation
+//
+// Loads the C reference model with the same IMEM/DMEM images as the RTL
+// and, in lockstep mode, steps it for every instruction the CPU retires
+// (RVFI), stopping the sim at the first PC, instruction or register write
+// that differs.
+//
+// Plusargs:
+//   +SVC_ISS_LOCKSTEP     Compare every retired instruction
+//   +SVC_ISS_FF=<N>       Fast-forward: the model runs the first N million
+//                         instructions before reset is released, then
+//                         svc_soc_sim hands its state to the RTL. With
+//                         +SVC_ISS_LOCKSTEP the compare starts there.
+//
+// The model is only loaded when one of them is given. Fast-forward itself
+// lives in svc_soc_sim, which owns the memories; it reads ff_instrs.
+//
+module svc_soc_sim_iss #(
+    parameter IMEM_INIT  = "",
+    parameter DMEM_INIT  = "",
+    parameter IMEM_DEPTH = 4096,
+    parameter DMEM_DEPTH = 1024,
+    parameter EXT_ZMMUL  = 0,
+    parameter EXT_M      = 0,
+    parameter CLOCK_FREQ = 100_000_000,
+    parameter BAUD_RATE  = 115_200
+) (
+    input logic        clk,
+    input logic        rst_n,
+    input logic        retire_valid,
+    input logic [31:0] retire_pc,
+    input logic [31:0] retire_insn,
+    input logic [ 4:0] retire_rd_addr,
+    input logic [31:0] retire_rd_wdata
+);
+  localparam int EXT = EXT_M ? 2 : EXT_ZMMUL ? 1 : 0;
+
+  bit     active;
+  bit     lockstep;
+  longint ff_instrs;
+  int     ff_millions;
+
+  initial begin
+    lockstep  = $test$plusargs("SVC_ISS_LOCKSTEP") != 0;
+    ff_instrs = 0;
+
+    if ($value$plusargs("SVC_ISS_FF=%d", ff_millions)) begin
+      ff_instrs = longint'(ff_millions) * SVC_ISS_FF_UNIT;
+    end
+
+    active = lockstep || ff_instrs != 0;
+    if (active) begin
+      if (svc_iss_init(IMEM_INIT, DMEM_INIT, IMEM_DEPTH, DMEM_DEPTH, EXT,
+                       CLOCK_FREQ, BAUD_RATE) != 0) begin
+        $fatal(1, "SVC_SOC_SIM_ISS: cannot load the program images");
+      end
+      if (lockstep) begin
+        $display("SVC_SOC_SIM_ISS: lockstep compare");
+      end
+      if (ff_instrs != 0) begin
+        $display("SVC_SOC_SIM_ISS: fast-forward %0d instrs", ff_instrs);
+      end
+    end
+  end
+
+  //
+  // Lockstep compare
+  //
+  always @(posedge clk) begin
+    if (rst_n && lockstep && retire_valid) begin
+      if (svc_iss_check(retire_pc, retire_insn, int'(retire_rd_addr),
+                        retire_rd_wdata) != 0) begin
+        $fatal(1, "SVC_SOC_SIM_ISS: RTL diverged from the reference model");
+      end
+    end
+  end
+
+  final begin
+    if (lockstep) begin
+      $display("SVC_SOC_SIM_ISS: %0d instrs checked", svc_iss_checked());
+    end
+  end
+
+endmodule
+
+`endif
@@ -0,0 +1,191 @@
+`ifndef SVC_SOC_SIM_PERF_SV
+`define SVC_SOC_SIM_PERF_SV
+
+`include "svc.sv"
+
+// Stall attribution events for SoC simulations
+//
+// Derives the svc_soc_io_reg perf_events bits from the CPU's retire port
+// and, in the cache SoC, the data memory AXI handshakes. Bit order:
+//
+//   0 load-use     1 mispredict   2 BTB miss     3 RAS miss
+//   4 I-cache miss 5 D-cache miss 6 memory wait
+//
+// Retire gaps: the cycles between two retires, less those spent on a
+// memory transaction, are charged to the first instruction when it
+// explains them:
+//
+//   load whose rd the next instruction reads   load-use
+//   conditional branch                         mispredict
+//   jal, or jalr other than a return           BTB miss
+//   return (jalr x0, 0(ra/t0))                 RAS miss
+//
+// Other gaps (multi-cycle ALU ops, CSR access) are not charged. A gap is
+// only known once it ends, so the event bit is raised for that many
+// cycles after the retire that ended it; a counter read right after a
+// stall can miss up to its length. This only makes sense for a pipelined
+// core, where back-to-back retires are the norm.
+//
+// AXI: D-cache miss is high while a read burst (cache refill) is
+// requested or outstanding, memory wait while any AXI transaction is in
+// flight and nothing retires. None of the SoCs has an I-cache, so bit 4
+// stays 0.
+//
+module svc_soc_sim_perf #(
+    parameter int GAP_WIDTH = 16
+) (
+    input logic clk,
+    input logic rst_n,
+
+    //
+    // CPU retire port (RVFI)
+    //
+    input logic        retire_valid,
+    input logic [31:0] retire_insn,
+
+    //
+    // Data memory AXI handshakes (tie to 0 without a cache)
+    //
+    input logic m_axi_arvalid,
+    input logic m_axi_arready,
+    input logic m_axi_rvalid,
+    input logic m_axi_rready,
+    input logic m_axi_rlast,
+    input logic m_axi_awvalid,
+    input logic m_axi_awready,
+    input logic m_axi_wvalid,
+    input logic m_axi_bvalid,
+    input logic m_axi_bready,
+
+    output logic [6:0] perf_events
+);
+  localparam int EV_LOAD_USE = 0;
+  localparam int EV_MISPREDICT = 1;
+  localparam int EV_BTB_MISS = 2;
+  localparam int EV_RAS_MISS = 3;
+  localparam int EV_ICACHE_MISS = 4;
+  localparam int EV_DCACHE_MISS = 5;
+  localparam int EV_MEM_WAIT = 6;
+
+  localparam logic [6:0] OP_LOAD = 7'b0000011;
+  localparam logic [6:0] OP_STORE = 7'b0100011;
+  localparam logic [6:0] OP_BRANCH = 7'b1100011;
+  localparam logic [6:0] OP_JALR = 7'b1100111;
+  localparam logic [6:0] OP_JAL = 7'b1101111;
+  localparam logic [6:0] OP_LUI = 7'b0110111;
+  localparam logic [6:0] OP_AUIPC = 7'b0010111;
+  localparam logic [6:0] OP_OP = 7'b0110011;
+
+  //
+  // AXI transactions in flight
+  //
+  logic [3:0] rd_out;
+  logic [3:0] wr_out;
+  logic       rd_busy;
+  logic       wr_busy;
+  logic       mem_busy;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      rd_out <= '0;
+      wr_out <= '0;
+    end else begin
+      rd_out <= rd_out + 4'(m_axi_arvalid && m_axi_arready) -
+          4'(m_axi_rvalid && m_axi_rready && m_axi_rlast);
+      wr_out <= wr_out + 4'(m_axi_awvalid && m_axi_awready) -
+          4'(m_axi_bvalid && m_axi_bready);
+    end
+  end
+
+  assign rd_busy  = m_axi_arvalid || rd_out != 0;
+  assign wr_busy  = m_axi_awvalid || m_axi_wvalid || wr_out != 0;
+  assign mem_busy = rd_busy || wr_busy;
+
+  //
+  // Retire gap attribution
+  //
+  logic                 prev_valid;
+  logic [         31:0] prev_insn;
+  logic [GAP_WIDTH-1:0] gap;
+  logic [         31:0] drain      [4];
+
+  logic [          6:0] prev_op;
+  logic [          4:0] prev_rd;
+  logic [          4:0] prev_rs1;
+  logic [          6:0] cur_op;
+  logic                 uses_rs1;
+  logic                 uses_rs2;
+  logic [          3:0] cause;
+
+  assign prev_op  = prev_insn[6:0];
+  assign prev_rd  = prev_insn[11:7];
+  assign prev_rs1 = prev_insn[19:15];
+  assign cur_op   = retire_insn[6:0];
+  assign uses_rs1 = !(cur_op inside {OP_LUI, OP_AUIPC, OP_JAL});
+  assign uses_rs2 = cur_op inside {OP_STORE, OP_BRANCH, OP_OP};
+
+  always_comb begin
+    cause = '0;
+
+    if (prev_valid) begin
+      case (prev_op)
+        OP_LOAD: begin
+          cause[EV_LOAD_USE] = (prev_rd != 0 &&
+                                ((uses_rs1 && retire_insn[19:15] == prev_rd) ||
+                                 (uses_rs2 && retire_insn[24:20] == prev_rd)));
+        end
+
+        OP_BRANCH: cause[EV_MISPREDICT] = 1'b1;
+
+        OP_JAL: cause[EV_BTB_MISS] = 1'b1;
+
+        OP_JALR: begin
+          if (prev_rd == 0 && (prev_rs1 == 5'd1 || prev_rs1 == 5'd5)) begin
+            cause[EV_RAS_MISS] = 1'b1;
+          end else begin
+            cause[EV_BTB_MISS] = 1'b1;
+          end
+        end
+
+        default: begin
+        end
+      endcase
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      prev_valid <= 1'b0;
+      prev_insn  <= 32'h0;
+      gap        <= '0;
+    end else if (retire_valid) begin
+      prev_valid <= 1'b1;
+      prev_insn  <= retire_insn;
+      gap        <= '0;
+    end else if (!mem_busy && gap != '1) begin
+      gap <= gap + 1'b1;
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    for (int i = 0; i < 4; i++) begin
+      if (!rst_n) begin
+        drain[i] <= 32'h0;
+      end else begin
+        drain[i] <= drain[i] - 32'(drain[i] != 0) +
+            (retire_valid && cause[i] ? 32'(gap) : 32'h0);
+      end
+    end
+  end
+
+  for (genvar i = 0; i < 4; i++) begin : gen_gap_events
+    assign perf_events[i] = drain[i] != 0;
+  end
+
+  assign perf_events[EV_ICACHE_MISS] = 1'b0;
+  assign perf_events[EV_DCACHE_MISS] = rd_busy;
+  assign perf_events[EV_MEM_WAIT]    = mem_busy && !retire_valid;
+
+endmodule
+
+`endif
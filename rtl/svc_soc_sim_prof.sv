@@ -0,0 +1,130 @@
+`ifndef SVC_SOC_SIM_PROF_SV
+`define SVC_SOC_SIM_PROF_SV
+
+`include "svc.sv"
+
+// Sampling PC profiler for SoC simulations
+//
+// Watches the CPU's retire port and writes a binary trace that
+// scripts/rv_prof symbolizes against the program ELF.
+//
+// Plusargs:
+//   +SVC_SIM_PROF=<file>       Trace file (profiling is off without it)
+//   +SVC_SIM_PROF_PERIOD=<N>   Sample every N cycles (default 100). 0
+//                              records every retired instruction, which
+//                              also lets rv_prof build a call graph.
+//
+// Trace format (little-endian):
+//   Header: "SVCPROF1", u32 period
+//   Record: u32 pc, u16 cycles, u16 stall_cycles
+//
+// Sampled mode charges each sample (period cycles) to the next instruction
+// to retire; the sample counts as stalled when nothing retired in the
+// sample cycle. Every-retire mode charges each instruction the cycles since
+// the previous retire, of which all but one are stalls.
+//
+module svc_soc_sim_prof (
+    input logic        clk,
+    input logic        rst_n,
+    input logic        retire_valid,
+    input logic [31:0] retire_pc
+);
+  localparam int DEFAULT_PERIOD = 100;
+
+  int     fd;
+  int     period;
+  string  path;
+
+  int     count;
+  int     since_retire;
+  int     pending;
+  bit     sample;
+  int     records;
+
+  task automatic put_u16(input int v);
+    $fwrite(fd, "%c%c", v[7:0], v[15:8]);
+  endtask
+
+  task automatic put_u32(input logic [31:0] v);
+    $fwrite(fd, "%c%c%c%c", v[7:0], v[15:8], v[23:16], v[31:24]);
+  endtask
+
+  task automatic put_record(input logic [31:0] pc, input int cycles,
+                            input int stall);
+    // Saturate rather than wrap on very long stalls
+    put_u32(pc);
+    put_u16(cycles > 16'hFFFF ? 16'hFFFF : cycles);
+    put_u16(stall > 16'hFFFF ? 16'hFFFF : stall);
+    records++;
+  endtask
+
+  initial begin
+    fd      = 0;
+    records = 0;
+
+    if ($value$plusargs("SVC_SIM_PROF=%s", path)) begin
+      if (!$value$plusargs("SVC_SIM_PROF_PERIOD=%d", period)) begin
+        period = DEFAULT_PERIOD;
+      end
+
+      fd = $fopen(path, "wb");
+      if (fd == 0) begin
+        $display("SVC_SOC_SIM_PROF: cannot open %s", path);
+      end else begin
+        $fwrite(fd, "SVCPROF1");
+        put_u32(period);
+        $display("SVC_SOC_SIM_PROF: %s, period %0d", path, period);
+      end
+    end
+  end
+
+  //
+  // Sampling
+  //
+  // Written with blocking assignments: this is testbench code that does
+  // file I/O from the clock edge, not logic.
+  //
+  always @(posedge clk) begin
+    if (!rst_n) begin
+      count        = 0;
+      since_retire = 0;
+      pending      = 0;
+    end else if (fd != 0) begin
+      if (period == 0) begin
+        // Every retire, with the cycles since the previous one
+        if (retire_valid) begin
+          put_record(retire_pc, since_retire + 1, since_retire);
+          since_retire = 0;
+        end else begin
+          since_retire = since_retire + 1;
+        end
+      end else begin
+        sample = (count == period - 1);
+        count  = sample ? 0 : count + 1;
+
+        if (retire_valid) begin
+          // Samples taken while nothing retired go to this instruction
+          if (pending != 0) begin
+            put_record(retire_pc, pending * period, pending * period);
+          end
+          if (sample) begin
+            put_record(retire_pc, period, 0);
+          end
+          pending = 0;
+        end else if (sample) begin
+          pending = pending + 1;
+        end
+      end
+    end
+  end
+
+  final begin
+    if (fd != 0) begin
+      $fclose(fd);
+      $display("SVC_SOC_SIM_PROF: %0d records", records);
+    end
+  end
+
+endmodule
+
+`endif
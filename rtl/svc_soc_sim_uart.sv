@@ -2,8 +2,8 @@
 `define SVC_SOC_SIM_UART_SV
 
 `include "svc.sv"
-`include "svc_uart_rx.sv"
-`include "svc_uart_tx.sv"
+`include "svc_soc_uart_rx.sv"
+`include "svc_soc_uart_tx.sv"
 
 // UART simulation model for SoC-level testbenches and standalone simulations
 //
@@ -11,11 +11,13 @@
 // It monitors the SoC's UART TX output and can drive the SoC's UART RX input.
 //
 // Features:
-// - Automatic RX monitoring with optional character printing (uses svc_uart_rx)
+// - Automatic RX monitoring with optional character printing
+// - Runtime baud changes via set_clk_div() to follow the SoC's divisor
 // - TX tasks for sending characters/strings to the SoC
 // - Character buffering for verification
 // - Statistics tracking
 // - Interactive stdin input (Verilator: DPI, Icarus: $fgetc)
+// - Raw output for a host tool on stdin/stdout (RAW_STDIN)
 //
 // Based on patterns from svc_uart_{rx,tx}_tb.sv and svc_model_sram.sv
 
@@ -37,7 +39,9 @@ module svc_soc_sim_uart #(
     parameter DEBUG = 0,
     parameter PREFIX = "",
     parameter DISABLE_PTY = 0,  // Set to 1 to disable PTY (stdout only)
-    parameter IMEM_DEPTH = 16384  // For rv_loader.py --imem-depth hint
+    parameter IMEM_DEPTH = 16384,  // For rv_loader.py --imem-depth hint
+    parameter STDIN_PLUSARG = "UART_STDIN",  // Plusarg for stdin input
+    parameter RAW_STDIN = 0  // With stdin input, print RX bytes as is
 ) (
     input  logic clk,
     input  logic rst_n,
@@ -64,6 +68,12 @@ module svc_soc_sim_uart #(
   string       P;
   bit          at_line_start;
 
+  // Clock cycles per bit, both directions
+  logic [15:0] clk_div;
+
+  // A host tool on stdin/stdout reads every byte, control bytes included
+  bit          raw;
+
   // Initialize
   initial begin
     // Build prefix string
@@ -74,20 +84,20 @@ module svc_soc_sim_uart #(
     end
 
     at_line_start = 1;
+    raw           = RAW_STDIN && $test$plusargs(STDIN_PLUSARG);
+    clk_div       = 16'(CLOCK_FREQ / BAUD_RATE);
     urx_ready     = 1'b1;  // Always ready to receive
     utx_valid     = 1'b0;  // Start with no TX data
     utx_data      = 8'h00;
   end
 
   //
-  // RX Monitor - uses svc_uart_rx to watch utx_pin (SoC's TX output)
+  // RX Monitor - watches utx_pin (SoC's TX output)
   //
-  svc_uart_rx #(
-      .CLOCK_FREQ(CLOCK_FREQ),
-      .BAUD_RATE (BAUD_RATE)
-  ) uart_rx_inst (
+  svc_soc_uart_rx uart_rx_inst (
       .clk      (clk),
       .rst_n    (rst_n),
+      .clk_div  (clk_div),
       .urx_valid(urx_valid),
       .urx_data (urx_data),
       .urx_ready(urx_ready),
@@ -107,7 +117,10 @@ module svc_soc_sim_uart #(
       rx_buffer.push_back(urx_data);
       rx_char_count = rx_char_count + 1;
 
-      if (PRINT_RX) begin
+      if (PRINT_RX && raw) begin
+        $write("%c", urx_data);
+        $fflush();
+      end else if (PRINT_RX) begin
         // Print character (handle special chars)
         if (urx_data == 8'h0A) begin
           $display("");
@@ -140,14 +153,12 @@ module svc_soc_sim_uart #(
   // verilator lint_on BLKSEQ
 
   //
-  // TX Driver - uses svc_uart_tx to drive urx_pin (SoC's RX input)
+  // TX Driver - drives urx_pin (SoC's RX input)
   //
-  svc_uart_tx #(
-      .CLOCK_FREQ(CLOCK_FREQ),
-      .BAUD_RATE (BAUD_RATE)
-  ) uart_tx_inst (
+  svc_soc_uart_tx uart_tx_inst (
       .clk      (clk),
       .rst_n    (rst_n),
+      .clk_div  (clk_div),
       .utx_valid(utx_valid),
       .utx_data (utx_data),
       .utx_ready(utx_ready),
@@ -204,6 +215,11 @@ module svc_soc_sim_uart #(
   // Utility tasks
   //
 
+  // Change the bit period (clock cycles per bit) to follow the SoC
+  task automatic set_clk_div(input logic [15:0] div);
+    clk_div = div;
+  endtask
+
   // Get received character from buffer (blocks if empty)
   task automatic get_rx_char(output logic [7:0] char_out);
     while (rx_buffer.size() == 0) begin
@@ -285,8 +301,9 @@ module svc_soc_sim_uart #(
   //
   // Interactive stdin reading (optional)
   //
-  // When enabled via +UART_STDIN plusarg, reads from stdin and sends to SoC.
-  // This allows interactive terminal I/O with the simulation.
+  // When enabled via +UART_STDIN plusarg (STDIN_PLUSARG), reads from stdin
+  // and sends to SoC. This allows interactive terminal I/O with the
+  // simulation.
   //
   // For non-blocking stdin access:
   //   - With Verilator: uses DPI-C functions
@@ -299,7 +316,7 @@ module svc_soc_sim_uart #(
     int stdin_enabled;
 
     stdin_enabled = 0;
-    if ($test$plusargs("UART_STDIN")) begin
+    if ($test$plusargs(STDIN_PLUSARG)) begin
       stdin_enabled = 1;
     end
 
@@ -330,7 +347,7 @@ module svc_soc_sim_uart #(
     int stdin_enabled;
 
     stdin_enabled = 0;
-    if ($test$plusargs("UART_STDIN")) begin
+    if ($test$plusargs(STDIN_PLUSARG)) begin
       stdin_enabled = 1;
     end
 
@@ -0,0 +1,120 @@
+`ifndef SVC_SOC_UART_RX_SV
+`define SVC_SOC_UART_RX_SV
+
+`include "svc.sv"
+
+//
+// UART receiver with a runtime bit period
+//
+// Same valid/ready interface as svc_uart_rx, but the baud rate comes from
+// the clk_div input (clock cycles per bit, at least 4) instead of
+// parameters. Each bit is sampled once, in the middle of its period,
+// after the start bit edge.
+//
+// Frame format: 8N1, LSB first. A frame whose stop bit is low is dropped.
+// A new byte replaces one that has not been accepted yet.
+//
+module svc_soc_uart_rx (
+    input logic clk,
+    input logic rst_n,
+
+    input logic [15:0] clk_div,
+
+    output logic       urx_valid,
+    output logic [7:0] urx_data,
+    input  logic       urx_ready,
+    input  logic       urx_pin
+);
+  typedef enum logic [1:0] {
+    STATE_IDLE,
+    STATE_START,
+    STATE_DATA,
+    STATE_STOP
+  } state_t;
+
+  state_t      state;
+  logic [ 1:0] pin_sync;
+  logic        pin;
+  logic [15:0] cnt;
+  logic [ 2:0] bit_idx;
+  logic [ 7:0] shift;
+
+  // Synchronize the asynchronous input
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      pin_sync <= 2'b11;
+    end else begin
+      pin_sync <= {pin_sync[0], urx_pin};
+    end
+  end
+
+  assign pin = pin_sync[1];
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      state     <= STATE_IDLE;
+      cnt       <= 16'd0;
+      bit_idx   <= 3'd0;
+      shift     <= 8'h00;
+      urx_valid <= 1'b0;
+      urx_data  <= 8'h00;
+    end else begin
+      if (urx_valid && urx_ready) begin
+        urx_valid <= 1'b0;
+      end
+
+      case (state)
+        STATE_IDLE: begin
+          if (!pin) begin
+            // Wait half a bit to land in the middle of the start bit
+            state <= STATE_START;
+            cnt   <= (clk_div >> 1) - 16'd1;
+          end
+        end
+
+        STATE_START: begin
+          if (cnt != 0) begin
+            cnt <= cnt - 16'd1;
+          end else if (pin) begin
+            // Glitch, not a start bit
+            state <= STATE_IDLE;
+          end else begin
+            state   <= STATE_DATA;
+            cnt     <= clk_div - 16'd1;
+            bit_idx <= 3'd0;
+          end
+        end
+
+        STATE_DATA: begin
+          if (cnt != 0) begin
+            cnt <= cnt - 16'd1;
+          end else begin
+            shift <= {pin, shift[7:1]};
+            cnt   <= clk_div - 16'd1;
+            if (bit_idx == 3'd7) begin
+              state <= STATE_STOP;
+            end
+            bit_idx <= bit_idx + 3'd1;
+          end
+        end
+
+        STATE_STOP: begin
+          if (cnt != 0) begin
+            cnt <= cnt - 16'd1;
+          end else begin
+            if (pin) begin
+              urx_valid <= 1'b1;
+              urx_data  <= shift;
+            end
+            state <= STATE_IDLE;
+          end
+        end
+
+        default: state <= STATE_IDLE;
+      endcase
+    end
+  end
+
+endmodule
+
+`endif
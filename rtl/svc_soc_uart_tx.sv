@@ -0,0 +1,59 @@
+`ifndef SVC_SOC_UART_TX_SV
+`define SVC_SOC_UART_TX_SV
+
+`include "svc.sv"
+
+//
+// UART transmitter with a runtime bit period
+//
+// Same valid/ready interface as svc_uart_tx, but the baud rate comes from
+// the clk_div input (clock cycles per bit) instead of parameters, so
+// software can change it on the fly. clk_div is sampled at the start of
+// each bit; change it only while the transmitter is idle.
+//
+// Frame format: 8N1, LSB first.
+//
+module svc_soc_uart_tx (
+    input logic clk,
+    input logic rst_n,
+
+    input logic [15:0] clk_div,
+
+    input  logic       utx_valid,
+    input  logic [7:0] utx_data,
+    output logic       utx_ready,
+    output logic       utx_pin
+);
+  // Start bit, 8 data bits, stop bit
+  logic [ 9:0] shift;
+  logic [ 3:0] bits_left;
+  logic [15:0] cnt;
+  logic        busy;
+
+  assign busy      = (bits_left != 0);
+  assign utx_ready = !busy;
+  assign utx_pin   = busy ? shift[0] : 1'b1;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      shift     <= '1;
+      bits_left <= 4'd0;
+      cnt       <= 16'd0;
+    end else if (!busy) begin
+      if (utx_valid) begin
+        shift     <= {1'b1, utx_data, 1'b0};
+        bits_left <= 4'd10;
+        cnt       <= clk_div - 16'd1;
+      end
+    end else if (cnt == 0) begin
+      shift     <= {1'b1, shift[9:1]};
+      bits_left <= bits_left - 4'd1;
+      cnt       <= clk_div - 16'd1;
+    end else begin
+      cnt <= cnt - 16'd1;
+    end
+  end
+
+endmodule
+
+`endif
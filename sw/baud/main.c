@@ -0,0 +1,33 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#include "libsvc/uart.h"
+
+//
+// Rate to switch to: 10 clocks per bit on the 25 MHz loader sim
+//
+#define BAUD_FAST 2500000
+
+//
+// Time the host console has to answer (ms)
+//
+#define BAUD_TIMEOUT_MS 1000
+
+//
+// Baud switch
+//
+// Asks the host console (rv_loader --console) to move the app UART to a
+// faster rate mid-run and greets it at both rates. Built with
+// SVC_EXIT_EOT, so the console returns when it is done.
+//
+int main(void) {
+  printf("Hello World at %lu baud\n", (unsigned long)svc_uart_get_baud());
+
+  if (svc_uart_negotiate_baud(BAUD_FAST, BAUD_TIMEOUT_MS) != 0) {
+    printf("No baud switch to %lu\n", (unsigned long)BAUD_FAST);
+    return 1;
+  }
+
+  printf("Hello World at %lu baud\n", (unsigned long)svc_uart_get_baud());
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include "arena.h"
+
+#include <unistd.h>
+
+static inline uint8_t *align_up(uint8_t *p, size_t align) {
+  return (uint8_t *)(((uintptr_t)p + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+//
+// Initialize an arena over a buffer
+//
+void svc_arena_init(svc_arena_t *a, void *buf, size_t size) {
+  uint8_t *start = buf;
+  uint8_t *end   = start + size;
+  uint8_t *base  = align_up(start, SVC_ARENA_ALIGN);
+
+  a->base = base > end ? end : base;
+  a->ptr  = a->base;
+  a->end  = end;
+}
+
+//
+// Initialize an arena with memory from sbrk()
+//
+int svc_arena_init_sbrk(svc_arena_t *a, size_t size) {
+  // Room to align the start
+  void *buf = sbrk((ptrdiff_t)(size + SVC_ARENA_ALIGN - 1));
+
+  if (buf == (void *)-1) {
+    a->base = NULL;
+    a->ptr  = NULL;
+    a->end  = NULL;
+    return -1;
+  }
+
+  svc_arena_init(a, buf, size + SVC_ARENA_ALIGN - 1);
+  a->end = a->base + size;
+
+  return 0;
+}
+
+//
+// Allocate with a specific alignment
+//
+// The next pointer is rounded back up to SVC_ARENA_ALIGN so the inline
+// svc_arena_alloc() can assume it is aligned.
+//
+void *svc_arena_alloc_aligned(svc_arena_t *a, size_t size, size_t align) {
+  uint8_t *p = align_up(a->ptr, align);
+
+  if (p > a->end || size > (size_t)(a->end - p)) {
+    return NULL;
+  }
+
+  uint8_t *next = align_up(p + size, SVC_ARENA_ALIGN);
+  a->ptr        = next > a->end ? a->end : next;
+
+  return p;
+}
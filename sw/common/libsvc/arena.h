@@ -0,0 +1,142 @@
+#ifndef LIBSVC_ARENA_H
+#define LIBSVC_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// Arena Allocator
+//
+// Bump allocation from one contiguous region, for objects that die
+// together. Allocation is a pointer add and a bounds check; objects carry
+// no header. Memory comes back all at once with svc_arena_reset(), or back
+// to a saved point with svc_arena_rewind().
+//
+// The region is a caller-provided buffer (static array, stack buffer) or
+// a block taken from sbrk(). sbrk memory is never returned to the heap.
+//
+// Example:
+//   static uint8_t buf[1024];
+//   svc_arena_t    a;
+//
+//   svc_arena_init(&a, buf, sizeof(buf));
+//   node_t *n = SVC_ARENA_NEW(&a, node_t);
+//
+//   svc_arena_mark_t m = svc_arena_mark(&a);
+//   char *tmp = svc_arena_alloc(&a, 64);  // scratch
+//   svc_arena_rewind(&a, m);               // tmp is gone, n is kept
+//
+
+//
+// Default alignment (largest scalar alignment on ilp32)
+//
+#define SVC_ARENA_ALIGN 8
+
+typedef struct {
+  uint8_t *base;
+  uint8_t *ptr;
+  uint8_t *end;
+} svc_arena_t;
+
+//
+// Saved allocation point
+//
+typedef uint8_t *svc_arena_mark_t;
+
+//
+// Initialize an arena over a buffer
+//
+// The start is rounded up to SVC_ARENA_ALIGN, so up to 7 bytes of the
+// buffer may go unused.
+//
+// Args:
+//   a:    Arena to initialize
+//   buf:  Backing memory
+//   size: Size of buf in bytes
+//
+void svc_arena_init(svc_arena_t *a, void *buf, size_t size);
+
+//
+// Initialize an arena with memory from sbrk()
+//
+// Args:
+//   a:    Arena to initialize
+//   size: Bytes to reserve
+//
+// Returns:
+//   0 on success, -1 if the heap can't grow by size bytes
+//
+int svc_arena_init_sbrk(svc_arena_t *a, size_t size);
+
+//
+// Allocate with a specific alignment
+//
+// Args:
+//   a:     Arena
+//   size:  Bytes to allocate
+//   align: Power of two alignment
+//
+// Returns:
+//   Pointer, or NULL if the arena is full
+//
+void *svc_arena_alloc_aligned(svc_arena_t *a, size_t size, size_t align);
+
+//
+// Allocate SVC_ARENA_ALIGN-aligned memory
+//
+// Returns:
+//   Pointer, or NULL if the arena is full
+//
+static inline void *svc_arena_alloc(svc_arena_t *a, size_t size) {
+  uint8_t *p = a->ptr;
+  size_t   n = (size + SVC_ARENA_ALIGN - 1) & ~(size_t)(SVC_ARENA_ALIGN - 1);
+
+  if (n > (size_t)(a->end - p) || n < size) {
+    return NULL;
+  }
+
+  a->ptr = p + n;
+  return p;
+}
+
+//
+// Allocate one object of a type
+//
+#define SVC_ARENA_NEW(a, type) ((type *)svc_arena_alloc((a), sizeof(type)))
+
+//
+// Save the current allocation point
+//
+static inline svc_arena_mark_t svc_arena_mark(const svc_arena_t *a) {
+  return a->ptr;
+}
+
+//
+// Free everything allocated since a mark
+//
+static inline void svc_arena_rewind(svc_arena_t *a, svc_arena_mark_t mark) {
+  a->ptr = mark;
+}
+
+//
+// Free everything in the arena
+//
+static inline void svc_arena_reset(svc_arena_t *a) {
+  a->ptr = a->base;
+}
+
+//
+// Bytes allocated
+//
+static inline size_t svc_arena_used(const svc_arena_t *a) {
+  return (size_t)(a->ptr - a->base);
+}
+
+//
+// Bytes still available
+//
+static inline size_t svc_arena_remaining(const svc_arena_t *a) {
+  return (size_t)(a->end - a->ptr);
+}
+
+#endif  // LIBSVC_ARENA_H
@@ -0,0 +1,49 @@
+#include "ckpt.h"
+
+#include <stdio.h>
+
+#include "uart.h"
+
+#ifndef SVC_DISABLE_MMIO
+#include "mmio.h"
+#endif
+
+//
+// Checkpoint request register (see svc_soc_sim)
+//
+#define SIM_CKPT_OFFSET 0x4C
+
+svc_ckpt_state_t svc_ckpt_state;
+
+void svc_ckpt_save(void) {
+  // Nothing may be left in flight: the restored run starts with empty
+  // UART FIFOs
+  fflush(stdout);
+  svc_uart_flush();
+
+#ifndef SVC_DISABLE_MMIO
+  svc_ckpt_state.stack_top = &svc_ckpt_state.stack[SVC_CKPT_STACK_WORDS];
+  svc_ckpt_state.magic     = SVC_CKPT_MAGIC;
+
+  // The sim dumps DMEM on this write, so the state above must land first
+  __asm__ volatile("" ::: "memory");
+  mmio_write(SIM_CKPT_OFFSET, 1);
+  __asm__ volatile("" ::: "memory");
+
+  // Only the dump may carry the magic: crt0 checks it before .bss is
+  // cleared, so a live one would turn any later reset that keeps DMEM
+  // into a jump back here
+  svc_ckpt_state.magic = 0;
+#endif
+}
+
+//
+// Called from crt0, on the checkpoint's own small stack, when the restored
+// DMEM holds a saved state
+//
+__attribute__((used, noreturn)) void svc_ckpt_resume(void) {
+  // Consume the checkpoint so a reset after this run boots normally
+  svc_ckpt_state.magic   = 0;
+  svc_ckpt_state.resumed = 1;
+  longjmp(svc_ckpt_state.jb, 1);
+}
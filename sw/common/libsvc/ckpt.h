@@ -0,0 +1,72 @@
+#ifndef LIBSVC_CKPT_H
+#define LIBSVC_CKPT_H
+
+#include <setjmp.h>
+#include <stdint.h>
+
+//
+// Simulation Checkpoints
+//
+// SVC_CKPT() marks a point the simulation can save and later resume from,
+// so runs that iterate on a hot loop skip crt0, library init and banner
+// output. It saves the callee-saved registers and stack pointer (setjmp),
+// drains the UART and asks the sim to dump DMEM (MMIO 0x4C). Everything
+// else the program needs, including the stack frames above the call, is
+// in that dump.
+//
+// A sim built with SVC_SIM_CKPT saves on +SVC_CKPT_SAVE=<file>, taking the
+// first SVC_CKPT() at or after +SVC_CKPT_AT=<cycle> (default 0). Restarted
+// with +SVC_CKPT_LOAD=<file>, it loads the dump before reset is released;
+// crt0 sees the saved state and returns from that SVC_CKPT() call instead
+// of starting over, and svc_ckpt_resumed() reports 1 from then on.
+//
+// Example:
+//   SVC_CKPT();
+//   uint32_t start = rdcycle();
+//   hot_loop();
+//
+// The sim's cycle and instret counters restart from reset, so measure
+// deltas from after the checkpoint. Without a sim (or with
+// SVC_DISABLE_MMIO) SVC_CKPT() costs a setjmp and a UART drain.
+//
+// The magic word is only set across the request write and is cleared again
+// right after it and on resume, so a reset that keeps DMEM never resumes a
+// stale checkpoint.
+//
+
+//
+// DMEM state shared with crt0 (magic at offset 0, stack_top at 4)
+//
+#define SVC_CKPT_MAGIC 0x434B5054u  // "CKPT"
+#define SVC_CKPT_STACK_WORDS 64
+
+typedef struct {
+  uint32_t  magic;
+  uint32_t *stack_top;  // crt0's stack while it calls svc_ckpt_resume
+  uint32_t  resumed;
+  jmp_buf   jb;
+  uint32_t  stack[SVC_CKPT_STACK_WORDS];
+} svc_ckpt_state_t;
+
+extern svc_ckpt_state_t svc_ckpt_state;
+
+//
+// Request the checkpoint (use SVC_CKPT)
+//
+void svc_ckpt_save(void);
+
+//
+// Non-zero once the program has been resumed from a checkpoint
+//
+static inline uint32_t svc_ckpt_resumed(void) {
+  return svc_ckpt_state.resumed;
+}
+
+#define SVC_CKPT()                        \
+  do {                                    \
+    if (setjmp(svc_ckpt_state.jb) == 0) { \
+      svc_ckpt_save();                    \
+    }                                     \
+  } while (0)
+
+#endif  // LIBSVC_CKPT_H
@@ -3,6 +3,10 @@
 
 #include <stdint.h>
 
+#ifndef SVC_DISABLE_MMIO
+#include "mmio.h"
+#endif
+
 //
 // RISC-V CSR (Control and Status Register) access functions
 //
@@ -10,6 +14,27 @@
 // using the Zicsr extension (rv32i_zicsr).
 //
 
+//
+// Stall attribution counters
+//
+// The SoC counts the cycles spent in each stall cause, in MMIO registers
+// at 0x50 + 4 * event. A write to the control register clears them all.
+// Miss events count one per miss cycle, so the counters read directly as
+// cycles lost. Only sims built with SVC_SIM_PERF raise the events;
+// elsewhere the counters read 0.
+//
+#define SVC_PERF_LOAD_USE 0
+#define SVC_PERF_MISPREDICT 1
+#define SVC_PERF_BTB_MISS 2
+#define SVC_PERF_RAS_MISS 3
+#define SVC_PERF_ICACHE_MISS 4
+#define SVC_PERF_DCACHE_MISS 5
+#define SVC_PERF_MEM_WAIT 6
+#define SVC_PERF_NUM_EVENTS 7
+
+#define SVC_PERF_BASE_OFFSET 0x50
+#define SVC_PERF_CTRL_OFFSET 0x6C
+
 #ifndef SVC_DISABLE_MMIO
 
 //
@@ -77,6 +102,20 @@ static inline uint64_t read_instret(void) {
   return ((uint64_t)hi << 32) | lo;
 }
 
+//
+// Read a stall attribution counter (SVC_PERF_*)
+//
+static inline uint32_t svc_perf_read(uint32_t event) {
+  return mmio_read(SVC_PERF_BASE_OFFSET + 4 * event);
+}
+
+//
+// Clear all stall attribution counters
+//
+static inline void svc_perf_reset(void) {
+  mmio_write(SVC_PERF_CTRL_OFFSET, 0);
+}
+
 #else  // SVC_DISABLE_MMIO
 
 //
@@ -112,6 +151,14 @@ static inline uint64_t read_instret(void) {
   return (uint64_t)(++call_count * 10);
 }
 
+static inline uint32_t svc_perf_read(uint32_t event) {
+  (void)event;
+  return 0;
+}
+
+static inline void svc_perf_reset(void) {
+}
+
 #endif  // SVC_DISABLE_MMIO
 
 #endif  // CSR_H
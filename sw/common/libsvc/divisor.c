@@ -0,0 +1,198 @@
+#include "divisor.h"
+
+#include "util.h"
+
+//
+// Shift-add term encoding: bits 5:0 = shift (0-32), bit 7 = subtract
+//
+#define TERM_SHIFT_MASK 0x3F
+#define TERM_NEG        0x80
+
+#ifndef __riscv_mul
+
+//
+// Recode a 32-bit constant into non-adjacent form
+//
+// NAF uses digits {-1, 0, +1} with no two adjacent non-zero digits, so a
+// 32-bit value needs at most 17 terms (vs up to 32 set bits in binary).
+// The value may need a digit at bit 32, so track it as a 33-bit hi:lo pair.
+//
+static uint8_t naf_terms(uint32_t value, uint8_t *terms) {
+  uint32_t lo    = value;
+  uint32_t hi    = 0;
+  uint8_t  count = 0;
+
+  for (uint8_t k = 0; (lo | hi) != 0; k++) {
+    if (lo & 1) {
+      if (lo & 2) {
+        // Digit -1: round up to clear the run of ones
+        terms[count++] = TERM_NEG | k;
+        lo += 1;
+        if (lo == 0) {
+          hi += 1;
+        }
+      } else {
+        terms[count++] = k;
+        lo -= 1;
+      }
+    }
+    lo = (lo >> 1) | (hi << 31);
+    hi >>= 1;
+  }
+
+  return count;
+}
+
+#endif  // __riscv_mul
+
+//
+// Precompute a divisor
+//
+void svc_divisor_init(svc_divisor_t *d, uint32_t divisor) {
+  d->divisor       = divisor;
+  d->magic         = 0;
+  d->shift1        = 0;
+  d->shift2        = 0;
+  d->magic_count   = 0;
+  d->divisor_count = 0;
+
+  if (divisor == 0) {
+    return;
+  }
+
+  //
+  // l = ceil(log2(divisor))
+  // magic = floor(2^32 * (2^l - divisor) / divisor) + 1
+  //
+  // 2^l - divisor < divisor, so the quotient fits in 32 bits. This is a
+  // 64/32 long division with a high word of (2^l - divisor) and a low word
+  // of 0. The carry out of the remainder shift covers divisors > 2^31.
+  //
+  uint32_t l   = (divisor == 1) ? 0 : 32 - svc_clz32(divisor - 1);
+  uint32_t rem = (l == 32) ? (0u - divisor) : (1u << l) - divisor;
+  uint32_t q   = 0;
+
+  for (int i = 0; i < 32; i++) {
+    uint32_t carry = rem >> 31;
+    rem <<= 1;
+    q <<= 1;
+    if (carry || rem >= divisor) {
+      rem -= divisor;
+      q |= 1;
+    }
+  }
+
+  d->magic  = q + 1;
+  d->shift1 = (l > 1) ? 1 : l;
+  d->shift2 = (l > 1) ? l - 1 : 0;
+
+#ifndef __riscv_mul
+  d->magic_count   = naf_terms(d->magic, d->magic_terms);
+  d->divisor_count = naf_terms(divisor, d->divisor_terms);
+#endif
+}
+
+#ifdef __riscv_mul
+
+//
+// High 32 bits of the product (single mulhu)
+//
+static inline uint32_t mulhi(const svc_divisor_t *d, uint32_t n) {
+  return (uint32_t)(((uint64_t)d->magic * n) >> 32);
+}
+
+//
+// Low 32 bits of q * divisor (single mul)
+//
+static inline uint32_t mullo(const svc_divisor_t *d, uint32_t q) {
+  return q * d->divisor;
+}
+
+#else  // __riscv_mul
+
+//
+// High 32 bits of magic * n, evaluated from the NAF terms
+//
+// Accumulates the full 64-bit product as a hi:lo pair so the result is
+// exact. Subtracted terms may wrap the intermediate sum; the final value is
+// the true product modulo 2^64.
+//
+static inline uint32_t mulhi(const svc_divisor_t *d, uint32_t n) {
+  uint32_t lo = 0;
+  uint32_t hi = 0;
+
+  for (uint8_t i = 0; i < d->magic_count; i++) {
+    uint8_t  t = d->magic_terms[i];
+    uint32_t k = t & TERM_SHIFT_MASK;
+    uint32_t plo;
+    uint32_t phi;
+
+    if (k == 0) {
+      plo = n;
+      phi = 0;
+    } else if (k == 32) {
+      plo = 0;
+      phi = n;
+    } else {
+      plo = n << k;
+      phi = n >> (32 - k);
+    }
+
+    if (t & TERM_NEG) {
+      phi += (lo < plo);
+      lo -= plo;
+      hi -= phi;
+    } else {
+      lo += plo;
+      hi += phi + (lo < plo);
+    }
+  }
+
+  return hi;
+}
+
+//
+// Low 32 bits of q * divisor, evaluated from the NAF terms
+//
+static inline uint32_t mullo(const svc_divisor_t *d, uint32_t q) {
+  uint32_t p = 0;
+
+  for (uint8_t i = 0; i < d->divisor_count; i++) {
+    uint8_t  t = d->divisor_terms[i];
+    uint32_t k = t & TERM_SHIFT_MASK;
+    uint32_t v = (k == 32) ? 0 : q << k;
+
+    if (t & TERM_NEG) {
+      p -= v;
+    } else {
+      p += v;
+    }
+  }
+
+  return p;
+}
+
+#endif  // __riscv_mul
+
+//
+// Divide by a precomputed divisor
+//
+uint32_t svc_divisor_div(const svc_divisor_t *d, uint32_t n) {
+  if (d->divisor == 0) {
+    return 0;  // Undefined behavior, but safe fallback
+  }
+
+  uint32_t t = mulhi(d, n);
+  return (t + ((n - t) >> d->shift1)) >> d->shift2;
+}
+
+//
+// Divide by a precomputed divisor, returning the remainder too
+//
+uint32_t svc_divisor_divmod(const svc_divisor_t *d, uint32_t n,
+                            uint32_t *rem) {
+  uint32_t q = svc_divisor_div(d, n);
+
+  *rem = (d->divisor == 0) ? 0 : n - mullo(d, q);
+  return q;
+}
@@ -0,0 +1,82 @@
+#ifndef LIBSVC_DIVISOR_H
+#define LIBSVC_DIVISOR_H
+
+#include <stdint.h>
+
+//
+// Invariant Divisor Layer
+//
+// Division by a runtime-invariant divisor (clock frequency, baud divider,
+// iteration count) using a precomputed multiply-shift "magic number"
+// (Granlund-Montgomery). Call svc_divisor_init() once, then divide as often
+// as needed without going through __udivsi3.
+//
+// With hardware multiply (rv32im, rv32i_zmmul) the high product is a single
+// mulhu. On plain rv32i, init also recodes the magic number and the divisor
+// into signed shift terms (non-adjacent form), so a divide is at most 17
+// shift-add steps instead of a bit-serial long division.
+//
+
+//
+// Maximum number of shift-add terms for a 32-bit constant in NAF
+//
+#define SVC_DIVISOR_MAX_TERMS 17
+
+//
+// Precomputed divisor
+//
+// Treat as opaque; fill with svc_divisor_init().
+//
+typedef struct {
+  uint32_t divisor;
+  uint32_t magic;
+  uint8_t  shift1;
+  uint8_t  shift2;
+
+  // Shift-add programs for rv32i (unused with hardware multiply)
+  uint8_t  magic_count;
+  uint8_t  divisor_count;
+  uint8_t  magic_terms[SVC_DIVISOR_MAX_TERMS];
+  uint8_t  divisor_terms[SVC_DIVISOR_MAX_TERMS];
+} svc_divisor_t;
+
+//
+// Precompute a divisor
+//
+// This does a one-time 64/32 long division to find the magic number, so
+// it costs about as much as a few __udivsi3 calls.
+//
+// Args:
+//   d:       Divisor object to fill
+//   divisor: Value to divide by (0 makes all divisions return 0, matching
+//            the __udivsi3 fallback)
+//
+void svc_divisor_init(svc_divisor_t *d, uint32_t divisor);
+
+//
+// Divide by a precomputed divisor
+//
+// Args:
+//   d: Divisor from svc_divisor_init()
+//   n: Dividend
+//
+// Returns:
+//   n / divisor (exact for all 32-bit n)
+//
+uint32_t svc_divisor_div(const svc_divisor_t *d, uint32_t n);
+
+//
+// Divide by a precomputed divisor, returning the remainder too
+//
+// Args:
+//   d:   Divisor from svc_divisor_init()
+//   n:   Dividend
+//   rem: Receives n % divisor
+//
+// Returns:
+//   n / divisor
+//
+uint32_t svc_divisor_divmod(const svc_divisor_t *d, uint32_t n,
+                            uint32_t *rem);
+
+#endif  // LIBSVC_DIVISOR_H
@@ -1,4 +1,9 @@
-#include <stdint.h>
+#include "divmod.h"
+
+#include <stddef.h>
+
+#include "mul.h"
+#include "util.h"
 
 //
 // Software implementation of division and modulo (signed and unsigned)
@@ -6,49 +11,92 @@
 // RV32I base ISA does not include hardware division/modulo instructions.
 // These are required for printf's number formatting and Dhrystone calculations.
 //
+// The core routine normalizes the divisor against the dividend with a
+// software clz, so the shift-subtract loop only runs once per quotient bit
+// instead of a fixed 32 times. Common cases (dividend < divisor, power-of-two
+// divisors) return without entering the loop at all.
+//
+// 64-bit division builds on a 64/32 step that estimates each 16-bit
+// quotient digit from the normalized divisor's top half and corrects it at
+// most twice (Knuth algorithm D, as in Hacker's Delight divlu), so a 64-bit
+// divide is a handful of 32-bit divides and multiplies rather than a 64
+// iteration bit loop.
+//
 
 //
-// Unsigned 32-bit division
+// Unsigned 32-bit division with remainder (core routine)
 //
-uint32_t __udivsi3(uint32_t dividend, uint32_t divisor) {
+static inline uint32_t udivmod(uint32_t dividend, uint32_t divisor,
+                               uint32_t *rem) {
   if (divisor == 0) {
-    return 0;  // Undefined behavior, but safe fallback
+    *rem = 0;  // Undefined behavior, but safe fallback
+    return 0;
   }
 
-  uint32_t quotient  = 0;
-  uint32_t remainder = 0;
+  // Quotient is 0, common for small values in printf digit loops
+  if (dividend < divisor) {
+    *rem = dividend;
+    return 0;
+  }
 
-  // Long division algorithm
-  for (int i = 31; i >= 0; i--) {
-    remainder = (remainder << 1) | ((dividend >> i) & 1);
-    if (remainder >= divisor) {
-      remainder -= divisor;
-      quotient |= (1u << i);
-    }
+  // Power-of-two divisor: shift and mask
+  if ((divisor & (divisor - 1)) == 0) {
+    *rem = dividend & (divisor - 1);
+    return dividend >> (31 - svc_clz32(divisor));
   }
 
+  //
+  // Align the divisor's MSB with the dividend's MSB. The quotient has at
+  // most shift+1 bits, so that is all the iterations we need. Stop early
+  // once the remainder hits zero since all remaining quotient bits are 0.
+  //
+  uint32_t shift    = svc_clz32(divisor) - svc_clz32(dividend);
+  uint32_t d        = divisor << shift;
+  uint32_t bit      = 1u << shift;
+  uint32_t quotient = 0;
+
+  do {
+    if (dividend >= d) {
+      dividend -= d;
+      quotient |= bit;
+    }
+    d >>= 1;
+    bit >>= 1;
+  } while (bit != 0 && dividend != 0);
+
+  *rem = dividend;
   return quotient;
 }
 
 //
-// Unsigned 32-bit modulo
+// Unsigned 32-bit division with remainder
 //
-uint32_t __umodsi3(uint32_t dividend, uint32_t divisor) {
-  if (divisor == 0) {
-    return 0;  // Undefined behavior, but safe fallback
+uint32_t __udivmodsi4(uint32_t dividend, uint32_t divisor, uint32_t *rem) {
+  uint32_t r;
+  uint32_t q = udivmod(dividend, divisor, &r);
+
+  if (rem) {
+    *rem = r;
   }
 
-  uint32_t remainder = 0;
+  return q;
+}
 
-  // Long division algorithm - only track remainder
-  for (int i = 31; i >= 0; i--) {
-    remainder = (remainder << 1) | ((dividend >> i) & 1);
-    if (remainder >= divisor) {
-      remainder -= divisor;
-    }
-  }
+//
+// Unsigned 32-bit division
+//
+uint32_t __udivsi3(uint32_t dividend, uint32_t divisor) {
+  uint32_t r;
+  return udivmod(dividend, divisor, &r);
+}
 
-  return remainder;
+//
+// Unsigned 32-bit modulo
+//
+uint32_t __umodsi3(uint32_t dividend, uint32_t divisor) {
+  uint32_t r;
+  udivmod(dividend, divisor, &r);
+  return r;
 }
 
 //
@@ -59,22 +107,16 @@ int32_t __divsi3(int32_t dividend, int32_t divisor) {
     return 0;  // Undefined behavior, but safe fallback
   }
 
-  // Handle signs
-  int negative = 0;
-  if (dividend < 0) {
-    negative = !negative;
-    dividend = -dividend;
-  }
-  if (divisor < 0) {
-    negative = !negative;
-    divisor  = -divisor;
-  }
+  // Handle signs (negate as unsigned so INT32_MIN doesn't overflow)
+  int      negative = (dividend < 0) != (divisor < 0);
+  uint32_t a = dividend < 0 ? -(uint32_t)dividend : (uint32_t)dividend;
+  uint32_t b = divisor < 0 ? -(uint32_t)divisor : (uint32_t)divisor;
 
   // Perform unsigned division
-  uint32_t quotient = __udivsi3((uint32_t)dividend, (uint32_t)divisor);
+  uint32_t quotient = __udivsi3(a, b);
 
   // Apply sign
-  return negative ? -(int32_t)quotient : (int32_t)quotient;
+  return negative ? (int32_t)(-quotient) : (int32_t)quotient;
 }
 
 //
@@ -86,11 +128,172 @@ int32_t __modsi3(int32_t dividend, int32_t divisor) {
   }
 
   // Modulo result should have the same sign as dividend
-  int negative = dividend < 0;
-  if (dividend < 0) dividend = -dividend;
-  if (divisor < 0) divisor = -divisor;
+  int      negative = dividend < 0;
+  uint32_t a = dividend < 0 ? -(uint32_t)dividend : (uint32_t)dividend;
+  uint32_t b = divisor < 0 ? -(uint32_t)divisor : (uint32_t)divisor;
+
+  uint32_t remainder = __umodsi3(a, b);
+
+  return negative ? (int32_t)(-remainder) : (int32_t)remainder;
+}
+
+//
+// 64/32 division by normalized estimate (core routine for 64-bit division)
+//
+// Divides hi:lo by divisor, which must be non-zero and greater than hi so
+// the quotient fits in 32 bits. The divisor is normalized so its MSB is
+// set; each 16-bit quotient digit is then estimated from its top half
+// (never more than 2 too large) and corrected.
+//
+static uint32_t udivmod64_32(uint32_t hi, uint32_t lo, uint32_t divisor,
+                             uint32_t *rem) {
+  const uint32_t base = 1u << 16;
+
+  uint32_t s   = svc_clz32(divisor);
+  uint32_t v   = divisor << s;
+  uint32_t vn1 = v >> 16;
+  uint32_t vn0 = v & 0xFFFF;
+
+  uint32_t un32 = (s == 0) ? hi : (hi << s) | (lo >> (32 - s));
+  uint32_t un10 = lo << s;
+  uint32_t un1  = un10 >> 16;
+  uint32_t un0  = un10 & 0xFFFF;
+
+  // High quotient digit
+  uint32_t rhat;
+  uint32_t q1 = udivmod(un32, vn1, &rhat);
+
+  while (q1 >= base || q1 * vn0 > (rhat << 16) + un1) {
+    q1 -= 1;
+    rhat += vn1;
+    if (rhat >= base) {
+      break;
+    }
+  }
+
+  // Low quotient digit
+  uint32_t un21 = (un32 << 16) + un1 - q1 * v;
+  uint32_t q0   = udivmod(un21, vn1, &rhat);
+
+  while (q0 >= base || q0 * vn0 > (rhat << 16) + un0) {
+    q0 -= 1;
+    rhat += vn1;
+    if (rhat >= base) {
+      break;
+    }
+  }
+
+  *rem = ((un21 << 16) + un0 - q0 * v) >> s;
+  return (q1 << 16) | q0;
+}
+
+//
+// Unsigned 64-bit division with remainder
+//
+uint64_t __udivmoddi4(uint64_t dividend, uint64_t divisor, uint64_t *rem) {
+  uint32_t nh = (uint32_t)(dividend >> 32);
+  uint32_t nl = (uint32_t)dividend;
+  uint32_t dh = (uint32_t)(divisor >> 32);
+  uint32_t dl = (uint32_t)divisor;
+  uint64_t quotient;
+  uint64_t remainder;
+
+  if (divisor == 0) {
+    quotient  = 0;  // Undefined behavior, but safe fallback
+    remainder = 0;
+  } else if (dividend < divisor) {
+    quotient  = 0;
+    remainder = dividend;
+  } else if (dh == 0) {
+    //
+    // 64/32: divide the high word first so the second step has hi < divisor,
+    // then finish with one 64/32 estimate. Both words fitting in 32 bits is
+    // the common case (time math on small values) and stays 32-bit.
+    //
+    uint32_t qh = 0;
+    uint32_t r;
+
+    if (nh == 0) {
+      quotient = udivmod(nl, dl, &r);
+    } else {
+      if (nh >= dl) {
+        qh = udivmod(nh, dl, &nh);
+      }
+      quotient = ((uint64_t)qh << 32) | udivmod64_32(nh, nl, dl, &r);
+    }
+    remainder = r;
+  } else {
+    //
+    // 64/64 with a divisor above 2^32: the quotient fits in 32 bits.
+    // Estimate it from the normalized divisor's top word against
+    // dividend / 2 (which keeps the 64/32 step from overflowing); the
+    // estimate is at most one too large after the decrement below.
+    //
+    uint32_t s  = svc_clz32(dh);
+    uint32_t v1 = (s == 0) ? dh : (dh << s) | (dl >> (32 - s));
+    uint32_t r;
+    uint32_t q = udivmod64_32(nh >> 1, (nh << 31) | (nl >> 1), v1, &r);
+
+    q >>= 31 - s;
+    if (q != 0) {
+      q -= 1;
+    }
+
+    remainder = dividend - svc_umul32x64(q, dl) - ((uint64_t)(q * dh) << 32);
+    if (remainder >= divisor) {
+      q += 1;
+      remainder -= divisor;
+    }
+    quotient = q;
+  }
+
+  if (rem) {
+    *rem = remainder;
+  }
+
+  return quotient;
+}
+
+//
+// Unsigned 64-bit division
+//
+uint64_t __udivdi3(uint64_t dividend, uint64_t divisor) {
+  return __udivmoddi4(dividend, divisor, NULL);
+}
+
+//
+// Unsigned 64-bit modulo
+//
+uint64_t __umoddi3(uint64_t dividend, uint64_t divisor) {
+  uint64_t remainder;
+
+  __udivmoddi4(dividend, divisor, &remainder);
+  return remainder;
+}
+
+//
+// Signed 64-bit division
+//
+int64_t __divdi3(int64_t dividend, int64_t divisor) {
+  int      negative = (dividend < 0) != (divisor < 0);
+  uint64_t a = dividend < 0 ? -(uint64_t)dividend : (uint64_t)dividend;
+  uint64_t b = divisor < 0 ? -(uint64_t)divisor : (uint64_t)divisor;
+
+  uint64_t quotient = __udivmoddi4(a, b, NULL);
+
+  return negative ? (int64_t)(-quotient) : (int64_t)quotient;
+}
+
+//
+// Signed 64-bit modulo
+//
+int64_t __moddi3(int64_t dividend, int64_t divisor) {
+  int      negative = dividend < 0;
+  uint64_t a = dividend < 0 ? -(uint64_t)dividend : (uint64_t)dividend;
+  uint64_t b = divisor < 0 ? -(uint64_t)divisor : (uint64_t)divisor;
+  uint64_t remainder;
 
-  uint32_t remainder = __umodsi3((uint32_t)dividend, (uint32_t)divisor);
+  __udivmoddi4(a, b, &remainder);
 
-  return negative ? -(int32_t)remainder : (int32_t)remainder;
+  return negative ? (int64_t)(-remainder) : (int64_t)remainder;
 }
@@ -0,0 +1,58 @@
+#ifndef LIBSVC_DIVMOD_H
+#define LIBSVC_DIVMOD_H
+
+#include <stdint.h>
+
+//
+// Soft Division Runtime
+//
+// libgcc-compatible division entry points for RV32I. The compiler calls
+// the 32-bit ones implicitly for / and % when the M extension is not
+// available, and the 64-bit ones on every RV32 variant (M has no 64-bit
+// divide).
+// They are declared here so libsvc code and tests can call them directly.
+//
+
+//
+// Unsigned 32-bit division with remainder
+//
+// Computes both results with a single division. Prefer this over a
+// separate / and % pair when both are needed.
+//
+// Args:
+//   dividend: Value to divide
+//   divisor:  Value to divide by (0 returns quotient 0, remainder 0)
+//   rem:      Receives the remainder (may be NULL)
+//
+// Returns:
+//   The quotient
+//
+uint32_t __udivmodsi4(uint32_t dividend, uint32_t divisor, uint32_t *rem);
+
+//
+// Unsigned 64-bit division with remainder
+//
+// Args:
+//   dividend: Value to divide
+//   divisor:  Value to divide by (0 returns quotient 0, remainder 0)
+//   rem:      Receives the remainder (may be NULL)
+//
+// Returns:
+//   The quotient
+//
+uint64_t __udivmoddi4(uint64_t dividend, uint64_t divisor, uint64_t *rem);
+
+//
+// Compiler runtime division/modulo
+//
+uint32_t __udivsi3(uint32_t dividend, uint32_t divisor);
+uint32_t __umodsi3(uint32_t dividend, uint32_t divisor);
+int32_t  __divsi3(int32_t dividend, int32_t divisor);
+int32_t  __modsi3(int32_t dividend, int32_t divisor);
+
+uint64_t __udivdi3(uint64_t dividend, uint64_t divisor);
+uint64_t __umoddi3(uint64_t dividend, uint64_t divisor);
+int64_t  __divdi3(int64_t dividend, int64_t divisor);
+int64_t  __moddi3(int64_t dividend, int64_t divisor);
+
+#endif  // LIBSVC_DIVMOD_H
@@ -0,0 +1,319 @@
+#include "fmt.h"
+
+#include "uart.h"
+
+//
+// Divide by 10 without division
+//
+// With hardware multiply, 0xCCCCCCCD / 2^35 is an exact reciprocal for all
+// 32-bit inputs. Without it, build n * 0.8 from shifts and adds (Hacker's
+// Delight divu10), which can come out one low, and correct from the
+// remainder.
+//
+static inline uint32_t divu10(uint32_t n, uint32_t *rem) {
+#ifdef __riscv_mul
+  uint32_t q = (uint32_t)(((uint64_t)n * 0xCCCCCCCDu) >> 35);
+  *rem       = n - ((q << 3) + (q << 1));
+  return q;
+#else
+  uint32_t q = (n >> 1) + (n >> 2);
+  q += q >> 4;
+  q += q >> 8;
+  q += q >> 16;
+  q >>= 3;
+
+  uint32_t r = n - ((q << 3) + (q << 1));
+  if (r > 9) {
+    q += 1;
+    r -= 10;
+  }
+
+  *rem = r;
+  return q;
+#endif
+}
+
+//
+// Write digits of value in reverse into the end of tmp
+//
+// Returns a pointer to the first (most significant) digit.
+//
+static char *utoa_rev(uint32_t value, char *end) {
+  char *p = end;
+
+  do {
+    uint32_t r;
+    value = divu10(value, &r);
+    *--p  = (char)('0' + r);
+  } while (value != 0);
+
+  return p;
+}
+
+static char *xtoa_rev(uint32_t value, char *end, int upper) {
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  char       *p      = end;
+
+  do {
+    *--p = digits[value & 0xF];
+    value >>= 4;
+  } while (value != 0);
+
+  return p;
+}
+
+static int copy_out(const char *src, const char *end, char *buf) {
+  int n = 0;
+
+  while (src < end) {
+    buf[n++] = *src++;
+  }
+  buf[n] = '\0';
+
+  return n;
+}
+
+//
+// Convert unsigned value to decimal
+//
+int svc_utoa(uint32_t value, char *buf) {
+  char  tmp[SVC_UTOA_BUF_SIZE];
+  char *end = tmp + sizeof(tmp);
+
+  return copy_out(utoa_rev(value, end), end, buf);
+}
+
+//
+// Convert signed value to decimal
+//
+int svc_itoa(int32_t value, char *buf) {
+  if (value < 0) {
+    buf[0] = '-';
+    return 1 + svc_utoa(-(uint32_t)value, buf + 1);
+  }
+
+  return svc_utoa((uint32_t)value, buf);
+}
+
+//
+// Convert unsigned value to hex
+//
+int svc_xtoa(uint32_t value, char *buf, int upper) {
+  char  tmp[SVC_XTOA_BUF_SIZE];
+  char *end = tmp + sizeof(tmp);
+
+  return copy_out(xtoa_rev(value, end, upper), end, buf);
+}
+
+//
+// Output sink: UART or a bounded buffer
+//
+typedef struct {
+  int    uart;
+  char  *buf;
+  size_t size;
+  size_t len;
+} fmt_out_t;
+
+static inline void out_char(fmt_out_t *o, char c) {
+  if (o->uart) {
+    svc_uart_putc(c);
+  } else if (o->len + 1 < o->size) {
+    o->buf[o->len] = c;
+  }
+  o->len++;
+}
+
+static void out_pad(fmt_out_t *o, char c, int count) {
+  while (count-- > 0) {
+    out_char(o, c);
+  }
+}
+
+//
+// Emit a field with optional sign prefix, padding and justification
+//
+static void out_field(fmt_out_t *o, const char *prefix, const char *s, int len,
+                      int width, int left, int zero) {
+  int plen = 0;
+
+  while (prefix[plen] != '\0') {
+    plen++;
+  }
+
+  int pad = width - plen - len;
+
+  if (!left && !zero) {
+    out_pad(o, ' ', pad);
+  }
+
+  for (int i = 0; i < plen; i++) {
+    out_char(o, prefix[i]);
+  }
+
+  if (!left && zero) {
+    out_pad(o, '0', pad);
+  }
+
+  for (int i = 0; i < len; i++) {
+    out_char(o, s[i]);
+  }
+
+  if (left) {
+    out_pad(o, ' ', pad);
+  }
+}
+
+//
+// Format engine shared by the UART and buffer variants
+//
+static void fmt_engine(fmt_out_t *o, const char *fmt, va_list ap) {
+  char tmp[SVC_ITOA_BUF_SIZE];
+
+  for (; *fmt != '\0'; fmt++) {
+    if (*fmt != '%') {
+      out_char(o, *fmt);
+      continue;
+    }
+
+    fmt++;
+
+    // Flags
+    int left = 0;
+    int zero = 0;
+    for (;; fmt++) {
+      if (*fmt == '-') {
+        left = 1;
+      } else if (*fmt == '0') {
+        zero = 1;
+      } else {
+        break;
+      }
+    }
+
+    // Width
+    int width = 0;
+    while (*fmt >= '0' && *fmt <= '9') {
+      width = (width << 3) + (width << 1) + (*fmt - '0');
+      fmt++;
+    }
+
+    // Length modifier (long is 32 bits on ilp32)
+    while (*fmt == 'l') {
+      fmt++;
+    }
+
+    char       *end    = tmp + sizeof(tmp);
+    const char *prefix = "";
+    char       *s;
+
+    switch (*fmt) {
+      case 'd':
+      case 'i': {
+        int v = va_arg(ap, int);
+        if (v < 0) {
+          prefix = "-";
+          s      = utoa_rev(-(uint32_t)v, end);
+        } else {
+          s = utoa_rev((uint32_t)v, end);
+        }
+        out_field(o, prefix, s, end - s, width, left, zero);
+        break;
+      }
+
+      case 'u':
+        s = utoa_rev(va_arg(ap, unsigned int), end);
+        out_field(o, prefix, s, end - s, width, left, zero);
+        break;
+
+      case 'x':
+      case 'X':
+        s = xtoa_rev(va_arg(ap, unsigned int), end, *fmt == 'X');
+        out_field(o, prefix, s, end - s, width, left, zero);
+        break;
+
+      case 'p':
+        s = xtoa_rev((uint32_t)(uintptr_t)va_arg(ap, void *), end, 0);
+        out_field(o, "0x", s, end - s, width, left, zero);
+        break;
+
+      case 'c':
+        tmp[0] = (char)va_arg(ap, int);
+        out_field(o, prefix, tmp, 1, width, left, 0);
+        break;
+
+      case 's': {
+        const char *str = va_arg(ap, const char *);
+        int         len = 0;
+
+        if (str == NULL) {
+          str = "(null)";
+        }
+        while (str[len] != '\0') {
+          len++;
+        }
+        out_field(o, prefix, str, len, width, left, 0);
+        break;
+      }
+
+      case '%':
+        out_char(o, '%');
+        break;
+
+      case '\0':
+        // Trailing '%': stop at the terminator
+        return;
+
+      default:
+        // Unsupported conversion: emit it verbatim
+        out_char(o, '%');
+        out_char(o, *fmt);
+        break;
+    }
+  }
+}
+
+//
+// Formatted output to the UART
+//
+int svc_vprintf(const char *fmt, va_list ap) {
+  fmt_out_t o = {1, NULL, 0, 0};
+
+  fmt_engine(&o, fmt, ap);
+  return (int)o.len;
+}
+
+int svc_printf(const char *fmt, ...) {
+  va_list ap;
+
+  va_start(ap, fmt);
+  int ret = svc_vprintf(fmt, ap);
+  va_end(ap);
+
+  return ret;
+}
+
+//
+// Formatted output to a buffer
+//
+int svc_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap) {
+  fmt_out_t o = {0, buf, size, 0};
+
+  fmt_engine(&o, fmt, ap);
+
+  if (size > 0) {
+    buf[o.len < size ? o.len : size - 1] = '\0';
+  }
+
+  return (int)o.len;
+}
+
+int svc_snprintf(char *buf, size_t size, const char *fmt, ...) {
+  va_list ap;
+
+  va_start(ap, fmt);
+  int ret = svc_vsnprintf(buf, size, fmt, ap);
+  va_end(ap);
+
+  return ret;
+}
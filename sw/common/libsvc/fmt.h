@@ -0,0 +1,90 @@
+#ifndef LIBSVC_FMT_H
+#define LIBSVC_FMT_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// Integer Formatting Layer
+//
+// Division-free integer to ASCII conversion and a small printf for the
+// common %d/%u/%x/%s formats. Decimal digits are produced with a
+// reciprocal multiply by 1/10 (shift-add on rv32i, mulhu with hardware
+// multiply), so nothing here calls __udivsi3/__umodsi3.
+//
+// Supported conversions: %d %i %u %x %X %c %s %p %%
+// Supported modifiers:   '-' and '0' flags, field width, 'l' (ignored,
+//                        long is 32 bits on ilp32)
+//
+
+//
+// Buffer sizes including the NUL terminator
+//
+#define SVC_UTOA_BUF_SIZE 11
+#define SVC_ITOA_BUF_SIZE 12
+#define SVC_XTOA_BUF_SIZE 9
+
+//
+// Convert unsigned value to decimal
+//
+// Args:
+//   value: Value to convert
+//   buf:   Output buffer, at least SVC_UTOA_BUF_SIZE bytes
+//
+// Returns:
+//   Number of characters written (excluding NUL)
+//
+int svc_utoa(uint32_t value, char *buf);
+
+//
+// Convert signed value to decimal
+//
+// Args:
+//   value: Value to convert
+//   buf:   Output buffer, at least SVC_ITOA_BUF_SIZE bytes
+//
+// Returns:
+//   Number of characters written (excluding NUL)
+//
+int svc_itoa(int32_t value, char *buf);
+
+//
+// Convert unsigned value to hex (no prefix, no leading zeros)
+//
+// Args:
+//   value: Value to convert
+//   buf:   Output buffer, at least SVC_XTOA_BUF_SIZE bytes
+//   upper: Non-zero for A-F, zero for a-f
+//
+// Returns:
+//   Number of characters written (excluding NUL)
+//
+int svc_xtoa(uint32_t value, char *buf, int upper);
+
+//
+// Formatted output to the UART
+//
+// Writes directly to the UART without going through stdio, so output is
+// not ordered with respect to buffered printf() output.
+//
+// Returns:
+//   Number of characters written
+//
+int svc_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+int svc_vprintf(const char *fmt, va_list ap);
+
+//
+// Formatted output to a buffer
+//
+// Follows snprintf semantics: output is truncated to size-1 characters
+// and always NUL terminated when size > 0.
+//
+// Returns:
+//   Number of characters that would have been written with enough space
+//
+int svc_snprintf(char *buf, size_t size, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+int svc_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap);
+
+#endif  // LIBSVC_FMT_H
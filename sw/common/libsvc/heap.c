@@ -0,0 +1,268 @@
+#include "heap.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include "util.h"
+
+//
+// Block layout
+//
+// [size | flags] [payload ...]
+//  4 bytes        8-byte aligned
+//
+// Block sizes are multiples of 8 and headers sit at 4 mod 8, so every
+// payload is 8-byte aligned. Free blocks keep their header (in-use bit
+// clear) and store the free list link in the first payload word.
+//
+#define HDR_SIZE   4
+#define HDR_IN_USE 0x1
+#define HDR_FLAGS  0x7
+
+//
+// Free list index for blocks above the largest class
+//
+#define LARGE_CLASS SVC_HEAP_NUM_CLASSES
+
+//
+// Largest request that still fits a 32-bit block size
+//
+#define MAX_REQUEST 0x7FFFFFF0u
+
+typedef struct free_block {
+  struct free_block *next;
+} free_block_t;
+
+static free_block_t    *free_lists[SVC_HEAP_NUM_CLASSES + 1];
+static svc_heap_stats_t heap_stats;
+
+static inline uint32_t *block_hdr(void *ptr) {
+  return (uint32_t *)ptr - 1;
+}
+
+//
+// Block size (header included, rounded to 8) for a request
+//
+static inline uint32_t block_size(size_t size) {
+  return ((uint32_t)size + HDR_SIZE + 7) & ~7u;
+}
+
+//
+// Smallest class that holds a block size (at most SVC_HEAP_MAX_CLASS_SIZE)
+//
+// Classes alternate between 2^k and 1.5 * 2^k, so the class follows from
+// the position of the top bit of size - 1 and the bit below it.
+//
+static inline uint32_t size_class(uint32_t size) {
+  if (size <= 16) {
+    return 0;
+  }
+
+  uint32_t k = 31 - svc_clz32(size - 1);
+
+  if (size - 1 < (3u << (k - 1))) {
+    return 2 * (k - 4) + 1;
+  }
+  return 2 * (k - 3);
+}
+
+//
+// Free list index of a block
+//
+static inline uint32_t block_class(uint32_t size) {
+  return size > SVC_HEAP_MAX_CLASS_SIZE ? LARGE_CLASS : size_class(size);
+}
+
+//
+// Take a new block from the top of the heap and write its header
+//
+static uint32_t *carve(uint32_t size) {
+  char    *top = sbrk(0);
+  uint32_t pad = (HDR_SIZE - (uint32_t)(uintptr_t)top) & 7;
+
+  if (top == (char *)-1 || sbrk(pad + size) == (void *)-1) {
+    return NULL;
+  }
+
+  uint32_t *hdr = (uint32_t *)(top + pad);
+  *hdr          = size;
+
+  heap_stats.carved_bytes += size;
+  return hdr;
+}
+
+//
+// Take a free block off a list
+//
+static inline uint32_t *unlink_free(free_block_t **link, uint32_t cls) {
+  free_block_t *blk = *link;
+  uint32_t     *hdr = block_hdr(blk);
+
+  *link = blk->next;
+  heap_stats.free_bytes -= *hdr;
+  heap_stats.class_free[cls]--;
+
+  return hdr;
+}
+
+static inline uint32_t *pop(uint32_t cls) {
+  if (free_lists[cls] == NULL) {
+    return NULL;
+  }
+
+  return unlink_free(&free_lists[cls], cls);
+}
+
+//
+// First-fit search of the large list
+//
+static uint32_t *pop_large(uint32_t size) {
+  free_block_t **link = &free_lists[LARGE_CLASS];
+
+  for (free_block_t *blk = *link; blk != NULL; blk = *link) {
+    if (*block_hdr(blk) >= size) {
+      return unlink_free(link, LARGE_CLASS);
+    }
+    link = &blk->next;
+  }
+
+  return NULL;
+}
+
+//
+// Allocate memory
+//
+void *svc_malloc(size_t size) {
+  uint32_t *hdr = NULL;
+
+  if (size > MAX_REQUEST) {
+    heap_stats.failures++;
+    return NULL;
+  }
+
+  uint32_t need = block_size(size);
+
+  if (need <= SVC_HEAP_MAX_CLASS_SIZE) {
+    uint32_t cls = size_class(need);
+
+    hdr = pop(cls);
+    if (hdr == NULL) {
+      hdr = carve(svc_heap_class_size(cls));
+    }
+
+    // Out of fresh memory: settle for a free block of a larger class
+    for (uint32_t c = cls + 1; hdr == NULL && c < SVC_HEAP_NUM_CLASSES; c++) {
+      hdr = pop(c);
+    }
+  } else {
+    hdr = pop_large(need);
+    if (hdr == NULL) {
+      hdr = carve(need);
+    }
+  }
+
+  if (hdr == NULL) {
+    heap_stats.failures++;
+    return NULL;
+  }
+
+  uint32_t bsize = *hdr;
+  *hdr           = bsize | HDR_IN_USE;
+
+  heap_stats.allocs++;
+  heap_stats.in_use_bytes += bsize;
+  heap_stats.class_in_use[block_class(bsize)]++;
+  if (heap_stats.in_use_bytes > heap_stats.peak_bytes) {
+    heap_stats.peak_bytes = heap_stats.in_use_bytes;
+  }
+
+  return hdr + 1;
+}
+
+//
+// Free memory
+//
+void svc_free(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  uint32_t *hdr = block_hdr(ptr);
+
+  // Ignore double frees rather than corrupting the list
+  if ((*hdr & HDR_IN_USE) == 0) {
+    return;
+  }
+
+  uint32_t bsize = *hdr & ~HDR_FLAGS;
+  uint32_t cls   = block_class(bsize);
+
+  *hdr                        = bsize;
+  ((free_block_t *)ptr)->next = free_lists[cls];
+  free_lists[cls]             = ptr;
+
+  heap_stats.frees++;
+  heap_stats.in_use_bytes -= bsize;
+  heap_stats.free_bytes += bsize;
+  heap_stats.class_in_use[cls]--;
+  heap_stats.class_free[cls]++;
+}
+
+//
+// Allocate zeroed memory for an array
+//
+void *svc_calloc(size_t nmemb, size_t size) {
+  if (size != 0 && nmemb > MAX_REQUEST / size) {
+    heap_stats.failures++;
+    return NULL;
+  }
+
+  size_t total = nmemb * size;
+  void  *ptr   = svc_malloc(total);
+
+  if (ptr != NULL) {
+    memset(ptr, 0, total);
+  }
+
+  return ptr;
+}
+
+//
+// Usable size of an allocation
+//
+size_t svc_malloc_usable_size(void *ptr) {
+  if (ptr == NULL) {
+    return 0;
+  }
+
+  return (*block_hdr(ptr) & ~HDR_FLAGS) - HDR_SIZE;
+}
+
+//
+// Resize an allocation
+//
+void *svc_realloc(void *ptr, size_t size) {
+  if (ptr == NULL) {
+    return svc_malloc(size);
+  }
+
+  size_t usable = svc_malloc_usable_size(ptr);
+  if (size <= usable) {
+    return ptr;
+  }
+
+  void *new_ptr = svc_malloc(size);
+  if (new_ptr != NULL) {
+    memcpy(new_ptr, ptr, usable);
+    svc_free(ptr);
+  }
+
+  return new_ptr;
+}
+
+//
+// Snapshot heap statistics
+//
+void svc_heap_stats(svc_heap_stats_t *stats) {
+  *stats = heap_stats;
+}
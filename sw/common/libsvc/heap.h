@@ -0,0 +1,108 @@
+#ifndef LIBSVC_HEAP_H
+#define LIBSVC_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// Size-Class Heap
+//
+// Segregated-fit allocator for small DMEM. Blocks come in fixed size
+// classes (16, 24, 32, 48, 64, ... 4096 bytes, two per power of two), each
+// with its own free list, so allocation and free are a class lookup and a
+// list push/pop. Blocks are carved from sbrk() on demand and never split or
+// merged; a freed block is reused by the next allocation of its class.
+//
+// Each block carries a 4-byte header holding its size, and payloads are
+// 8-byte aligned. Requests larger than the biggest class get an exact-size
+// block on a separate first-fit list.
+//
+// svc_malloc() and friends are always available. To make them the
+// program's malloc(), set SVC_MALLOC = 1 in the program Makefile; this
+// links malloc.o ahead of picolibc.
+//
+
+//
+// Number of size classes (largest class is SVC_HEAP_MAX_CLASS_SIZE bytes
+// including the header)
+//
+#define SVC_HEAP_NUM_CLASSES 17
+#define SVC_HEAP_MAX_CLASS_SIZE 4096
+
+//
+// Heap statistics
+//
+// Byte counts include block headers and rounding, so
+// in_use_bytes + free_bytes == carved_bytes.
+//
+typedef struct {
+  uint32_t carved_bytes;  // Taken from sbrk so far
+  uint32_t in_use_bytes;  // In allocated blocks
+  uint32_t free_bytes;    // On free lists
+  uint32_t peak_bytes;    // High-water mark of in_use_bytes
+  uint32_t allocs;        // Successful allocations
+  uint32_t frees;         // Blocks freed
+  uint32_t failures;      // Allocations that returned NULL
+
+  // Per-class block counts (last entry: blocks above the largest class)
+  uint16_t class_in_use[SVC_HEAP_NUM_CLASSES + 1];
+  uint16_t class_free[SVC_HEAP_NUM_CLASSES + 1];
+} svc_heap_stats_t;
+
+//
+// Allocate memory
+//
+// Returns:
+//   8-byte aligned pointer (unique even for size 0), or NULL if the heap
+//   is exhausted
+//
+void *svc_malloc(size_t size);
+
+//
+// Free memory from svc_malloc/svc_calloc/svc_realloc (NULL is ignored)
+//
+void svc_free(void *ptr);
+
+//
+// Allocate zeroed memory for an array
+//
+// Returns:
+//   Pointer, or NULL if the size overflows or the heap is exhausted
+//
+void *svc_calloc(size_t nmemb, size_t size);
+
+//
+// Resize an allocation
+//
+// Returns the same pointer when the block already has room, otherwise
+// moves the data to a new block.
+//
+// Returns:
+//   Pointer to the resized block, or NULL (original block untouched)
+//
+void *svc_realloc(void *ptr, size_t size);
+
+//
+// Usable size of an allocation (at least the requested size)
+//
+size_t svc_malloc_usable_size(void *ptr);
+
+//
+// Snapshot heap statistics
+//
+// Args:
+//   stats: Filled with the current counters
+//
+void svc_heap_stats(svc_heap_stats_t *stats);
+
+//
+// Block size (including header) of a size class
+//
+// Args:
+//   cls: Class index, 0 to SVC_HEAP_NUM_CLASSES - 1
+//
+static inline uint32_t svc_heap_class_size(uint32_t cls) {
+  return ((cls & 1) ? 24u : 16u) << (cls >> 1);
+}
+
+#endif  // LIBSVC_HEAP_H
@@ -0,0 +1,64 @@
+//
+// malloc() family on top of the libsvc size-class heap
+//
+// Not part of libsvc.a: programs opt in with SVC_MALLOC = 1, which links
+// this object ahead of picolibc so these definitions win.
+//
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "heap.h"
+
+void *malloc(size_t size) {
+  return svc_malloc(size);
+}
+
+void free(void *ptr) {
+  svc_free(ptr);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+  return svc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  return svc_realloc(ptr, size);
+}
+
+size_t malloc_usable_size(void *ptr) {
+  return svc_malloc_usable_size(ptr);
+}
+
+//
+// Aligned allocation
+//
+// Payloads are 8-byte aligned and blocks are never split, so stricter
+// alignments are refused.
+//
+void *aligned_alloc(size_t alignment, size_t size) {
+  if (alignment > 8 || (alignment & (alignment - 1)) != 0) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  return svc_malloc(size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+  return aligned_alloc(alignment, size);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) {
+  if (alignment < sizeof(void *)) {
+    return EINVAL;
+  }
+
+  void *ptr = aligned_alloc(alignment, size);
+  if (ptr == NULL) {
+    return alignment > 8 ? EINVAL : ENOMEM;
+  }
+
+  *memptr = ptr;
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include "mem.h"
+
+#include <stdio.h>
+
+#include "fmt.h"
+#include "uart.h"
+
+//
+// Layout from the linker script, peak break from sbrk() in syscalls.c
+//
+extern char  __heap_start;
+extern char  __stack_top;
+extern char *__heap_peak;
+
+//
+// Measure memory usage so far
+//
+void svc_mem_stats(svc_mem_stats_t *stats) {
+  uintptr_t heap_start = (uintptr_t)&__heap_start;
+  uintptr_t heap_peak  = (uintptr_t)__heap_peak;
+  uintptr_t stack_top  = (uintptr_t)&__stack_top;
+
+  // Lowest word the stack has written
+  const uint32_t *p   = (const uint32_t *)((heap_peak + 3) & ~(uintptr_t)3);
+  const uint32_t *top = (const uint32_t *)stack_top;
+
+  while (p < top && *p == SVC_MEM_CANARY) {
+    p++;
+  }
+
+  // DMEM starts at address 0
+  stats->dmem_size    = (uint32_t)stack_top;
+  stats->static_bytes = (uint32_t)heap_start;
+  stats->heap_bytes   = (uint32_t)(heap_peak - heap_start);
+  stats->stack_bytes  = (uint32_t)(stack_top - (uintptr_t)p);
+  stats->free_bytes   = (uint32_t)((uintptr_t)p - heap_peak);
+}
+
+#ifndef SVC_DISABLE_MMIO
+
+#include "mmio.h"
+
+//
+// Simulation report registers (ignored by the hardware, latched by
+// svc_soc_sim)
+//
+#define SIM_MEM_STACK_OFFSET 0x40
+#define SIM_MEM_HEAP_OFFSET 0x44
+
+static void sim_report(const svc_mem_stats_t *stats) {
+  mmio_write(SIM_MEM_STACK_OFFSET, stats->stack_bytes);
+  mmio_write(SIM_MEM_HEAP_OFFSET, stats->heap_bytes);
+}
+
+#else  // SVC_DISABLE_MMIO
+
+static void sim_report(const svc_mem_stats_t *stats) {
+  (void)stats;
+}
+
+#endif  // SVC_DISABLE_MMIO
+
+//
+// Print memory usage to the UART
+//
+void svc_mem_report(void) {
+  svc_mem_stats_t st;
+
+  svc_mem_stats(&st);
+
+  // Keep the report after anything still buffered in stdio
+  fflush(stdout);
+
+  svc_printf("mem: dmem %u static %u heap %u stack %u free %u bytes\n",
+             (unsigned)st.dmem_size, (unsigned)st.static_bytes,
+             (unsigned)st.heap_bytes, (unsigned)st.stack_bytes,
+             (unsigned)st.free_bytes);
+  svc_uart_flush();
+
+  sim_report(&st);
+}
@@ -0,0 +1,53 @@
+#ifndef LIBSVC_MEM_H
+#define LIBSVC_MEM_H
+
+#include <stdint.h>
+
+//
+// Memory Usage Instrumentation
+//
+// When this module is linked, crt0 paints everything between the end of
+// .bss and the top of the stack with SVC_MEM_CANARY before main runs, and
+// sbrk() records the highest break it hands out. At any later point the
+// stack high-water mark is the lowest word above the heap peak that no
+// longer holds the canary.
+//
+// To print a report when main returns or exit() is called, set
+// SVC_MEM_REPORT = 1 in the program Makefile.
+//
+
+//
+// Fill pattern for untouched DMEM (must match crt0.S)
+//
+#define SVC_MEM_CANARY 0xC0DEF00Du
+
+//
+// Measured DMEM usage in bytes
+//
+typedef struct {
+  uint32_t dmem_size;     // Total data memory
+  uint32_t static_bytes;  // Everything below the heap (.data, .bss, ...)
+  uint32_t heap_bytes;    // Peak sbrk() break above the heap start
+  uint32_t stack_bytes;   // Deepest stack use seen
+  uint32_t free_bytes;    // Never touched between heap peak and stack
+} svc_mem_stats_t;
+
+//
+// Measure memory usage so far
+//
+// Scans the painted gap, so the cost is proportional to the free space.
+//
+// Args:
+//   stats: Filled with the current figures
+//
+void svc_mem_stats(svc_mem_stats_t *stats);
+
+//
+// Print memory usage to the UART
+//
+// Also writes the stack and heap figures to the simulation report
+// registers, which svc_soc_sim prints at the end of the run.
+//
+void svc_mem_report(void);
+
+#endif  // LIBSVC_MEM_H
@@ -0,0 +1,133 @@
+#include "mul.h"
+
+//
+// Software implementation of multiply for RV32I
+//
+// The smaller operand drives the loop so small multipliers (array indexing,
+// scaling by constants that the compiler couldn't strength-reduce) finish
+// in a few iterations. Wider multipliers switch to a radix-16 scheme: build
+// a 16-entry table of a * 0..15 once, then consume the multiplier a nibble
+// at a time, which is a quarter of the iterations of bit-serial shift-add.
+//
+// Note: nothing in this file may use * on 32-bit or wider values, or the
+// compiler would call back into these routines.
+//
+
+//
+// Multiplier width at which the nibble table pays for itself
+//
+#define MUL_NIBBLE_MIN 0x100
+
+//
+// Unsigned 32-bit multiply (low 32 bits)
+//
+uint32_t __mulsi3(uint32_t a, uint32_t b) {
+  // Let the operand with fewer significant bits drive the loop
+  if (a < b) {
+    uint32_t t = a;
+    a          = b;
+    b          = t;
+  }
+
+  uint32_t result = 0;
+
+  //
+  // Shift-add with early termination: at most 8 iterations here, and 0
+  // for b == 0.
+  //
+  if (b < MUL_NIBBLE_MIN) {
+    while (b != 0) {
+      if (b & 1) {
+        result += a;
+      }
+      a <<= 1;
+      b >>= 1;
+    }
+    return result;
+  }
+
+  //
+  // Radix-16: a * 0..15 from shifts and adds (spelled out so the compiler
+  // can't turn it back into a multiply), then one lookup per nibble.
+  //
+  uint32_t tab[16];
+  tab[0]  = 0;
+  tab[1]  = a;
+  tab[2]  = a << 1;
+  tab[3]  = tab[2] + a;
+  tab[4]  = a << 2;
+  tab[5]  = tab[4] + a;
+  tab[6]  = tab[3] << 1;
+  tab[7]  = tab[6] + a;
+  tab[8]  = a << 3;
+  tab[9]  = tab[8] + a;
+  tab[10] = tab[5] << 1;
+  tab[11] = tab[10] + a;
+  tab[12] = tab[6] << 1;
+  tab[13] = tab[12] + a;
+  tab[14] = tab[7] << 1;
+  tab[15] = tab[14] + a;
+
+  for (uint32_t shift = 0; b != 0; b >>= 4, shift += 4) {
+    result += tab[b & 0xF] << shift;
+  }
+
+  return result;
+}
+
+//
+// Unsigned 32x32 multiply, full 64-bit product
+//
+// With hardware multiply this is a mul/mulhu pair. Otherwise schoolbook on
+// 16-bit halves: each partial product has a 16-bit multiplier, so __mulsi3
+// needs at most 4 nibble steps for each.
+//
+uint64_t svc_umul32x64(uint32_t a, uint32_t b) {
+#ifdef __riscv_mul
+  return (uint64_t)a * b;
+#else
+  uint32_t a0 = a & 0xFFFF;
+  uint32_t a1 = a >> 16;
+  uint32_t b0 = b & 0xFFFF;
+  uint32_t b1 = b >> 16;
+
+  uint32_t p00 = __mulsi3(a0, b0);
+  uint32_t p01 = __mulsi3(a0, b1);
+  uint32_t p10 = __mulsi3(a1, b0);
+  uint32_t p11 = __mulsi3(a1, b1);
+
+  // Middle terms can carry into bit 32 of their sum
+  uint32_t mid       = p01 + p10;
+  uint32_t mid_carry = (mid < p01) ? 0x10000 : 0;
+
+  uint32_t lo = p00 + (mid << 16);
+  uint32_t hi = p11 + (mid >> 16) + mid_carry + (lo < p00);
+
+  return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+//
+// Unsigned 64-bit multiply (low 64 bits)
+//
+// Only the low half of the cross products reaches the result, and the
+// high words are usually zero, so those terms are often skipped.
+//
+uint64_t __muldi3(uint64_t a, uint64_t b) {
+  uint32_t al = (uint32_t)a;
+  uint32_t ah = (uint32_t)(a >> 32);
+  uint32_t bl = (uint32_t)b;
+  uint32_t bh = (uint32_t)(b >> 32);
+
+  uint64_t result = svc_umul32x64(al, bl);
+  uint32_t cross  = 0;
+
+  if (ah != 0) {
+    cross += __mulsi3(ah, bl);
+  }
+  if (bh != 0) {
+    cross += __mulsi3(al, bh);
+  }
+
+  return result + ((uint64_t)cross << 32);
+}
@@ -0,0 +1,33 @@
+#ifndef LIBSVC_MUL_H
+#define LIBSVC_MUL_H
+
+#include <stdint.h>
+
+//
+// Soft Multiply Runtime
+//
+// libgcc-compatible multiply entry points for RV32I. The compiler calls
+// these implicitly for 32-bit and 64-bit * when neither the M extension nor
+// Zmmul is available. They are declared here so libsvc code and tests can
+// call them directly.
+//
+
+//
+// Unsigned 32x32 multiply, full 64-bit product
+//
+// Args:
+//   a: First operand
+//   b: Second operand
+//
+// Returns:
+//   a * b without truncation
+//
+uint64_t svc_umul32x64(uint32_t a, uint32_t b);
+
+//
+// Compiler runtime multiply (low bits of the product)
+//
+uint32_t __mulsi3(uint32_t a, uint32_t b);
+uint64_t __muldi3(uint64_t a, uint64_t b);
+
+#endif  // LIBSVC_MUL_H
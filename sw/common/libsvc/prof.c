@@ -0,0 +1,265 @@
+#include "prof.h"
+
+#include <stdio.h>
+
+#include "csr.h"
+#include "fmt.h"
+#include "uart.h"
+
+//
+// Active zone entry
+//
+// The parent's totals must not include the time its descendants spend in
+// enter/exit, so each frame collects that overhead (nested_*) along with
+// the children's inclusive totals (child_*) for the self figures.
+//
+typedef struct {
+  svc_prof_zone_t *zone;
+  uint32_t         start_cycles;
+  uint32_t         start_instrs;
+  uint32_t         child_cycles;
+  uint32_t         child_instrs;
+  uint32_t         nested_cycles;
+  uint32_t         nested_instrs;
+} prof_frame_t;
+
+static svc_prof_zone_t *zones[SVC_PROF_MAX_ZONES];
+static uint32_t         num_zones;
+
+static prof_frame_t stack[SVC_PROF_MAX_DEPTH];
+static uint32_t     depth;
+static uint32_t     overflow_depth;
+static uint32_t     errors;
+
+//
+// Calibrated overhead
+//
+// inner: counted between the reads of an empty zone's enter and exit
+// outer: what a whole enter/exit pair adds to the enclosing zone
+//
+static uint8_t  calibrated;
+static uint32_t inner_cycles;
+static uint32_t inner_instrs;
+static uint32_t outer_cycles;
+static uint32_t outer_instrs;
+
+#define CALIBRATE_RUNS 8
+
+static inline uint32_t sub_floor(uint32_t a, uint32_t b) {
+  return a > b ? a - b : 0;
+}
+
+static void calibrate(void);
+
+//
+// Enter a zone
+//
+void svc_prof_enter(svc_prof_zone_t *zone) {
+  if (!calibrated) {
+    calibrate();
+  }
+
+  if (!zone->registered) {
+    if (num_zones == SVC_PROF_MAX_ZONES) {
+      errors++;
+      overflow_depth++;
+      return;
+    }
+    zones[num_zones++] = zone;
+    zone->registered   = 1;
+  }
+
+  if (depth == SVC_PROF_MAX_DEPTH || overflow_depth != 0) {
+    errors++;
+    overflow_depth++;
+    return;
+  }
+
+  prof_frame_t *f  = &stack[depth++];
+  f->zone          = zone;
+  f->child_cycles  = 0;
+  f->child_instrs  = 0;
+  f->nested_cycles = 0;
+  f->nested_instrs = 0;
+
+  // Sample last so the bookkeeping above isn't counted
+  f->start_cycles = rdcycle();
+  f->start_instrs = rdinstret();
+}
+
+//
+// Exit a zone
+//
+void svc_prof_exit(svc_prof_zone_t *zone) {
+  // Sample first, in the reverse order of enter
+  uint32_t now_instrs = rdinstret();
+  uint32_t now_cycles = rdcycle();
+
+  if (overflow_depth != 0) {
+    overflow_depth--;
+    return;
+  }
+
+  if (depth == 0 || stack[depth - 1].zone != zone) {
+    errors++;
+    return;
+  }
+
+  prof_frame_t *f = &stack[--depth];
+
+  uint32_t cycles = sub_floor(now_cycles - f->start_cycles,
+                              inner_cycles + f->nested_cycles);
+  uint32_t instrs = sub_floor(now_instrs - f->start_instrs,
+                              inner_instrs + f->nested_instrs);
+
+  zone->calls++;
+  zone->cycles += cycles;
+  zone->instrs += instrs;
+  zone->self_cycles += sub_floor(cycles, f->child_cycles);
+  zone->self_instrs += sub_floor(instrs, f->child_instrs);
+
+  if (depth != 0) {
+    prof_frame_t *parent = &stack[depth - 1];
+
+    parent->child_cycles += cycles;
+    parent->child_instrs += instrs;
+    parent->nested_cycles += outer_cycles + f->nested_cycles;
+    parent->nested_instrs += outer_instrs + f->nested_instrs;
+  }
+}
+
+//
+// Measure the enter/exit overhead
+//
+// Runs empty and nested-empty zones with no correction applied and keeps
+// the minimum of several runs, so a stray stall doesn't inflate it.
+//
+static void calibrate(void) {
+  static svc_prof_zone_t outer = {.name = "", .registered = 1};
+  static svc_prof_zone_t inner = {.name = "", .registered = 1};
+
+  uint32_t min_inner_c = UINT32_MAX;
+  uint32_t min_inner_i = UINT32_MAX;
+  uint32_t min_outer_c = UINT32_MAX;
+  uint32_t min_outer_i = UINT32_MAX;
+
+  calibrated = 1;
+
+  for (int i = 0; i < CALIBRATE_RUNS; i++) {
+    svc_prof_enter(&inner);
+    svc_prof_exit(&inner);
+
+    if ((uint32_t)inner.cycles < min_inner_c) {
+      min_inner_c = (uint32_t)inner.cycles;
+    }
+    if ((uint32_t)inner.instrs < min_inner_i) {
+      min_inner_i = (uint32_t)inner.instrs;
+    }
+    inner.cycles = 0;
+    inner.instrs = 0;
+  }
+
+  for (int i = 0; i < CALIBRATE_RUNS; i++) {
+    svc_prof_enter(&outer);
+    svc_prof_enter(&inner);
+    svc_prof_exit(&inner);
+    svc_prof_exit(&outer);
+
+    // The outer window holds its own inner overhead plus one nested pair
+    uint32_t c = sub_floor((uint32_t)outer.cycles, min_inner_c);
+    uint32_t n = sub_floor((uint32_t)outer.instrs, min_inner_i);
+
+    if (c < min_outer_c) {
+      min_outer_c = c;
+    }
+    if (n < min_outer_i) {
+      min_outer_i = n;
+    }
+    outer.cycles = 0;
+    outer.instrs = 0;
+  }
+
+  inner_cycles = min_inner_c;
+  inner_instrs = min_inner_i;
+  outer_cycles = min_outer_c;
+  outer_instrs = min_outer_i;
+}
+
+//
+// Format a 64-bit count in decimal
+//
+static const char *u64_str(uint64_t v, char *buf) {
+  if (v <= UINT32_MAX) {
+    svc_utoa((uint32_t)v, buf);
+  } else {
+    // Up to 10 digits above the low 9 (fits 2^64 / 10^9 for any real run)
+    uint32_t hi = (uint32_t)(v / 1000000000u);
+    uint32_t lo = (uint32_t)(v % 1000000000u);
+    int      n  = svc_utoa(hi, buf);
+
+    for (int i = n + 8; i >= n; i--) {
+      buf[i] = (char)('0' + lo % 10);
+      lo /= 10;
+    }
+    buf[n + 9] = '\0';
+  }
+
+  return buf;
+}
+
+//
+// Print zone totals
+//
+void svc_prof_dump(void) {
+  char cyc[21];
+  char self[21];
+  char ins[21];
+
+  // Keep the report after anything still buffered in stdio
+  fflush(stdout);
+
+  svc_printf("prof: %-16s %8s %12s %12s %12s %6s\n", "zone", "calls",
+             "cycles", "self", "self instrs", "CPI");
+
+  for (uint32_t i = 0; i < num_zones; i++) {
+    const svc_prof_zone_t *z = zones[i];
+
+    // Self CPI in hundredths: the zone's own code, not its callees
+    uint32_t cpi = z->self_instrs == 0
+                       ? 0
+                       : (uint32_t)(z->self_cycles * 100 / z->self_instrs);
+
+    svc_printf("prof: %-16s %8u %12s %12s %12s %3u.%02u\n", z->name,
+               (unsigned)z->calls, u64_str(z->cycles, cyc),
+               u64_str(z->self_cycles, self), u64_str(z->self_instrs, ins),
+               (unsigned)(cpi / 100), (unsigned)(cpi % 100));
+  }
+
+  if (errors != 0) {
+    svc_printf("prof: %u unmatched or dropped enter/exit calls\n",
+               (unsigned)errors);
+  }
+
+  svc_uart_flush();
+}
+
+//
+// Clear zone totals
+//
+void svc_prof_reset(void) {
+  for (uint32_t i = 0; i < num_zones; i++) {
+    svc_prof_zone_t *z = zones[i];
+
+    z->calls       = 0;
+    z->cycles      = 0;
+    z->instrs      = 0;
+    z->self_cycles = 0;
+    z->self_instrs = 0;
+  }
+
+  errors = 0;
+}
+
+uint32_t svc_prof_errors(void) {
+  return errors;
+}
@@ -0,0 +1,112 @@
+#ifndef LIBSVC_PROF_H
+#define LIBSVC_PROF_H
+
+#include <stdint.h>
+
+//
+// Scoped Profiling Zones
+//
+// Named zones accumulate cycles, retired instructions and call counts from
+// the cycle/instret CSRs. Zones nest: each one reports inclusive totals
+// (everything between enter and exit) and self totals (minus the zones
+// entered inside it). The cost of the enter/exit calls themselves is
+// measured once and subtracted, from the zone and from its parents, so an
+// empty zone reports ~0 cycles.
+//
+// Zones are static objects that register themselves on first entry; no
+// setup call is needed. Define SVC_PROF_DISABLE to compile the macros out.
+//
+// Example:
+//   SVC_PROF_ZONE(z_parse, "parse");
+//
+//   void parse(void) {
+//     SVC_PROF_ENTER(z_parse);
+//     ...
+//     SVC_PROF_EXIT(z_parse);
+//   }
+//
+//   void step(void) {
+//     SVC_PROF_SCOPE(z_step);   // exits automatically at end of scope
+//     ...
+//   }
+//
+//   svc_prof_dump();
+//
+// Counters are sampled as 32-bit values, so one zone entry must last less
+// than 2^32 cycles.
+//
+
+//
+// Table sizes
+//
+#define SVC_PROF_MAX_ZONES 32
+#define SVC_PROF_MAX_DEPTH 16
+
+typedef struct {
+  const char *name;
+  uint8_t     registered;
+  uint32_t    calls;
+  uint64_t    cycles;       // Inclusive
+  uint64_t    instrs;       // Inclusive
+  uint64_t    self_cycles;  // Excluding nested zones
+  uint64_t    self_instrs;  // Excluding nested zones
+} svc_prof_zone_t;
+
+//
+// Enter and exit a zone (use the macros below)
+//
+void svc_prof_enter(svc_prof_zone_t *zone);
+void svc_prof_exit(svc_prof_zone_t *zone);
+
+//
+// Print one line per zone: calls, inclusive and self cycles, CPI
+//
+void svc_prof_dump(void);
+
+//
+// Clear all zone totals (zones stay registered)
+//
+void svc_prof_reset(void);
+
+//
+// Number of enter/exit calls that were dropped (nesting deeper than
+// SVC_PROF_MAX_DEPTH, more than SVC_PROF_MAX_ZONES zones, or an exit that
+// didn't match the innermost zone)
+//
+uint32_t svc_prof_errors(void);
+
+static inline void svc_prof_scope_exit(svc_prof_zone_t **zone) {
+  svc_prof_exit(*zone);
+}
+
+#ifndef SVC_PROF_DISABLE
+
+//
+// Define a zone (at file scope or as a function-local static)
+//
+#define SVC_PROF_ZONE(var, zname) static svc_prof_zone_t var = {.name = zname}
+
+#define SVC_PROF_ENTER(var) svc_prof_enter(&(var))
+#define SVC_PROF_EXIT(var) svc_prof_exit(&(var))
+
+//
+// Define a zone named after var and profile the rest of the enclosing
+// block
+//
+#define SVC_PROF_SCOPE(var)                                           \
+  SVC_PROF_ZONE(var, #var);                                           \
+  svc_prof_zone_t *var##_scope                                        \
+      __attribute__((cleanup(svc_prof_scope_exit), unused)) = &(var); \
+  svc_prof_enter(&(var))
+
+#else  // SVC_PROF_DISABLE
+
+#define SVC_PROF_ZONE(var, zname) \
+  static const char var##_unused __attribute__((unused)) = 0
+#define SVC_PROF_ENTER(var) ((void)0)
+#define SVC_PROF_EXIT(var) ((void)0)
+#define SVC_PROF_SCOPE(var) ((void)0)
+
+#endif  // SVC_PROF_DISABLE
+
+#endif  // LIBSVC_PROF_H
@@ -0,0 +1,378 @@
+#include "str.h"
+
+//
+// Word type for aligned accesses into byte buffers
+//
+// may_alias keeps the optimizer (and LTO, once these are inlined into
+// callers) from assuming word stores can't change char data.
+//
+typedef uint32_t __attribute__((may_alias)) word_t;
+
+#define WORD_SIZE  4
+#define WORD_MASK  (WORD_SIZE - 1)
+#define ONES       0x01010101u
+#define HIGHS      0x80808080u
+
+//
+// Below this many bytes the alignment work costs more than it saves
+//
+#define SMALL_COPY 8
+
+//
+// Non-zero iff some byte of w is zero
+//
+static inline uint32_t has_zero(uint32_t w) {
+  return (w - ONES) & ~w & HIGHS;
+}
+
+static inline uint32_t misalign(const void *p) {
+  return (uint32_t)(uintptr_t)p & WORD_MASK;
+}
+
+//
+// Copy n bytes
+//
+// Once dst is aligned, a src with the same alignment copies 8 words per
+// iteration. Otherwise each output word is merged from two aligned source
+// words with shifts, so every load and store is still a full word.
+//
+void *svc_memcpy(void *dst, const void *src, size_t n) {
+  uint8_t       *d = dst;
+  const uint8_t *s = src;
+
+  if (n >= SMALL_COPY) {
+    // Head: align dst
+    while (misalign(d) != 0) {
+      *d++ = *s++;
+      n--;
+    }
+
+    uint32_t off = misalign(s);
+
+    if (off == 0) {
+      word_t       *dw = (word_t *)d;
+      const word_t *sw = (const word_t *)s;
+
+      while (n >= 8 * WORD_SIZE) {
+        uint32_t w0 = sw[0];
+        uint32_t w1 = sw[1];
+        uint32_t w2 = sw[2];
+        uint32_t w3 = sw[3];
+        uint32_t w4 = sw[4];
+        uint32_t w5 = sw[5];
+        uint32_t w6 = sw[6];
+        uint32_t w7 = sw[7];
+
+        dw[0] = w0;
+        dw[1] = w1;
+        dw[2] = w2;
+        dw[3] = w3;
+        dw[4] = w4;
+        dw[5] = w5;
+        dw[6] = w6;
+        dw[7] = w7;
+
+        dw += 8;
+        sw += 8;
+        n -= 8 * WORD_SIZE;
+      }
+
+      while (n >= WORD_SIZE) {
+        *dw++ = *sw++;
+        n -= WORD_SIZE;
+      }
+
+      d = (uint8_t *)dw;
+      s = (const uint8_t *)sw;
+    } else {
+      // Little-endian: low bytes of the output come from the high bytes
+      // of the earlier source word
+      uint32_t      rs   = off * 8;
+      uint32_t      ls   = 32 - rs;
+      word_t       *dw   = (word_t *)d;
+      const word_t *sw   = (const word_t *)(s - off);
+      uint32_t      prev = *sw++;
+
+      while (n >= 4 * WORD_SIZE) {
+        uint32_t w0 = sw[0];
+        uint32_t w1 = sw[1];
+        uint32_t w2 = sw[2];
+        uint32_t w3 = sw[3];
+
+        dw[0] = (prev >> rs) | (w0 << ls);
+        dw[1] = (w0 >> rs) | (w1 << ls);
+        dw[2] = (w1 >> rs) | (w2 << ls);
+        dw[3] = (w2 >> rs) | (w3 << ls);
+
+        prev = w3;
+        dw += 4;
+        sw += 4;
+        n -= 4 * WORD_SIZE;
+      }
+
+      while (n >= WORD_SIZE) {
+        uint32_t w = *sw++;
+        *dw++      = (prev >> rs) | (w << ls);
+        prev       = w;
+        n -= WORD_SIZE;
+      }
+
+      d = (uint8_t *)dw;
+      s = (const uint8_t *)sw - WORD_SIZE + off;
+    }
+  }
+
+  // Tail
+  while (n != 0) {
+    *d++ = *s++;
+    n--;
+  }
+
+  return dst;
+}
+
+//
+// Copy n bytes (regions may overlap)
+//
+// Forward copies are safe whenever dst is below src (every word is loaded
+// before the store that could overlap it), so only dst above src inside
+// the source runs backwards: a byte head to align the end of dst, words
+// when the ends share alignment, then bytes.
+//
+void *svc_memmove(void *dst, const void *src, size_t n) {
+  uint8_t       *d = dst;
+  const uint8_t *s = src;
+
+  if (d <= s || d >= s + n) {
+    return svc_memcpy(dst, src, n);
+  }
+
+  d += n;
+  s += n;
+
+  if (n >= SMALL_COPY && misalign(d) == misalign(s)) {
+    while (misalign(d) != 0) {
+      *--d = *--s;
+      n--;
+    }
+
+    word_t       *dw = (word_t *)d;
+    const word_t *sw = (const word_t *)s;
+
+    while (n >= 4 * WORD_SIZE) {
+      uint32_t w0 = sw[-1];
+      uint32_t w1 = sw[-2];
+      uint32_t w2 = sw[-3];
+      uint32_t w3 = sw[-4];
+
+      dw[-1] = w0;
+      dw[-2] = w1;
+      dw[-3] = w2;
+      dw[-4] = w3;
+
+      dw -= 4;
+      sw -= 4;
+      n -= 4 * WORD_SIZE;
+    }
+
+    while (n >= WORD_SIZE) {
+      *--dw = *--sw;
+      n -= WORD_SIZE;
+    }
+
+    d = (uint8_t *)dw;
+    s = (const uint8_t *)sw;
+  }
+
+  while (n != 0) {
+    *--d = *--s;
+    n--;
+  }
+
+  return dst;
+}
+
+//
+// Fill n bytes
+//
+void *svc_memset(void *dst, int c, size_t n) {
+  uint8_t *d = dst;
+  uint8_t  b = (uint8_t)c;
+
+  if (n >= SMALL_COPY) {
+    // Splat with shifts: a multiply would call __mulsi3 on RV32I
+    uint32_t w = b;
+    w |= w << 8;
+    w |= w << 16;
+
+    while (misalign(d) != 0) {
+      *d++ = b;
+      n--;
+    }
+
+    word_t *dw = (word_t *)d;
+
+    while (n >= 8 * WORD_SIZE) {
+      dw[0] = w;
+      dw[1] = w;
+      dw[2] = w;
+      dw[3] = w;
+      dw[4] = w;
+      dw[5] = w;
+      dw[6] = w;
+      dw[7] = w;
+      dw += 8;
+      n -= 8 * WORD_SIZE;
+    }
+
+    while (n >= WORD_SIZE) {
+      *dw++ = w;
+      n -= WORD_SIZE;
+    }
+
+    d = (uint8_t *)dw;
+  }
+
+  while (n != 0) {
+    *d++ = b;
+    n--;
+  }
+
+  return dst;
+}
+
+//
+// Compare n bytes
+//
+// Equal words are skipped 4 at a time when both buffers share alignment;
+// the first differing word is then resolved bytewise.
+//
+int svc_memcmp(const void *a, const void *b, size_t n) {
+  const uint8_t *pa = a;
+  const uint8_t *pb = b;
+
+  if (n >= SMALL_COPY && misalign(pa) == misalign(pb)) {
+    while (misalign(pa) != 0) {
+      if (*pa != *pb) {
+        return *pa - *pb;
+      }
+      pa++;
+      pb++;
+      n--;
+    }
+
+    const word_t *wa = (const word_t *)pa;
+    const word_t *wb = (const word_t *)pb;
+
+    while (n >= 4 * WORD_SIZE) {
+      if (wa[0] != wb[0] || wa[1] != wb[1] || wa[2] != wb[2] ||
+          wa[3] != wb[3]) {
+        break;
+      }
+      wa += 4;
+      wb += 4;
+      n -= 4 * WORD_SIZE;
+    }
+
+    while (n >= WORD_SIZE && *wa == *wb) {
+      wa++;
+      wb++;
+      n -= WORD_SIZE;
+    }
+
+    pa = (const uint8_t *)wa;
+    pb = (const uint8_t *)wb;
+  }
+
+  while (n != 0) {
+    if (*pa != *pb) {
+      return *pa - *pb;
+    }
+    pa++;
+    pb++;
+    n--;
+  }
+
+  return 0;
+}
+
+//
+// Length of a string
+//
+size_t svc_strlen(const char *s) {
+  const char *p = s;
+
+  while (misalign(p) != 0) {
+    if (*p == '\0') {
+      return (size_t)(p - s);
+    }
+    p++;
+  }
+
+  const word_t *w = (const word_t *)p;
+
+  while (!has_zero(w[0])) {
+    if (has_zero(w[1])) {
+      w += 1;
+      break;
+    }
+    w += 2;
+  }
+
+  // The terminator is in *w
+  p = (const char *)w;
+  while (*p != '\0') {
+    p++;
+  }
+
+  return (size_t)(p - s);
+}
+
+//
+// Compare strings
+//
+// With a shared alignment, words are compared until one differs or holds
+// the terminator; bytes settle the result from there.
+//
+int svc_strcmp(const char *a, const char *b) {
+  const uint8_t *pa = (const uint8_t *)a;
+  const uint8_t *pb = (const uint8_t *)b;
+
+  if (misalign(pa) == misalign(pb)) {
+    while (misalign(pa) != 0) {
+      if (*pa == '\0' || *pa != *pb) {
+        return *pa - *pb;
+      }
+      pa++;
+      pb++;
+    }
+
+    const word_t *wa = (const word_t *)pa;
+    const word_t *wb = (const word_t *)pb;
+
+    for (;;) {
+      uint32_t x = wa[0];
+      if (x != wb[0] || has_zero(x)) {
+        break;
+      }
+      x = wa[1];
+      if (x != wb[1] || has_zero(x)) {
+        wa++;
+        wb++;
+        break;
+      }
+      wa += 2;
+      wb += 2;
+    }
+
+    pa = (const uint8_t *)wa;
+    pb = (const uint8_t *)wb;
+  }
+
+  while (*pa != '\0' && *pa == *pb) {
+    pa++;
+    pb++;
+  }
+
+  return *pa - *pb;
+}
@@ -0,0 +1,63 @@
+#ifndef LIBSVC_STR_H
+#define LIBSVC_STR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// Word-at-a-time String and Memory Functions
+//
+// RV32I versions of the hot <string.h> routines. Each one handles the
+// unaligned head a byte at a time, moves whole words through an unrolled
+// inner loop, and finishes the tail a byte at a time. With single-cycle
+// DMEM and no cache, a word access costs the same as a byte access, so the
+// word loops move up to 4x the data per load/store.
+//
+// The string scans use SWAR zero-byte detection: a word contains a zero
+// byte iff (w - 0x01010101) & ~w & 0x80808080 is non-zero. Words are only
+// loaded while the previous one held no terminator, so a scan never reads
+// past the aligned word that holds the end of the string.
+//
+// svc_memcpy() and friends are always available. To make them the
+// program's memcpy(), set SVC_STRING = 1 in the program Makefile; this
+// links string.o ahead of picolibc.
+//
+
+//
+// Copy n bytes (regions must not overlap)
+//
+void *svc_memcpy(void *dst, const void *src, size_t n);
+
+//
+// Copy n bytes (regions may overlap)
+//
+void *svc_memmove(void *dst, const void *src, size_t n);
+
+//
+// Fill n bytes with (unsigned char)c
+//
+void *svc_memset(void *dst, int c, size_t n);
+
+//
+// Compare n bytes
+//
+// Returns:
+//   <0, 0, >0 as the first differing byte (unsigned) of a is less than,
+//   equal to, or greater than that of b
+//
+int svc_memcmp(const void *a, const void *b, size_t n);
+
+//
+// Length of a NUL-terminated string
+//
+size_t svc_strlen(const char *s);
+
+//
+// Compare NUL-terminated strings
+//
+// Returns:
+//   <0, 0, >0 like svc_memcmp, comparing bytes as unsigned char
+//
+int svc_strcmp(const char *a, const char *b);
+
+#endif  // LIBSVC_STR_H
@@ -0,0 +1,34 @@
+//
+// <string.h> routines on top of the libsvc word-at-a-time versions
+//
+// Not part of libsvc.a: programs opt in with SVC_STRING = 1, which links
+// this object ahead of picolibc so these definitions win.
+//
+
+#include <string.h>
+
+#include "str.h"
+
+void *memcpy(void *dst, const void *src, size_t n) {
+  return svc_memcpy(dst, src, n);
+}
+
+void *memmove(void *dst, const void *src, size_t n) {
+  return svc_memmove(dst, src, n);
+}
+
+void *memset(void *dst, int c, size_t n) {
+  return svc_memset(dst, c, n);
+}
+
+int memcmp(const void *a, const void *b, size_t n) {
+  return svc_memcmp(a, b, n);
+}
+
+size_t strlen(const char *s) {
+  return svc_strlen(s);
+}
+
+int strcmp(const char *a, const char *b) {
+  return svc_strcmp(a, b);
+}
@@ -1,5 +1,9 @@
 #include "uart.h"
 
+#include "csr.h"
+#include "fmt.h"
+#include "sys.h"
+
 #ifndef SVC_DISABLE_MMIO
 
 #include "mmio.h"
@@ -8,27 +12,154 @@
 // UART register offsets
 //
 // UART TX data register at MMIO_BASE + 0x00
-// UART TX status register at MMIO_BASE + 0x04 (bit 0 = TX ready)
-// UART RX data register at MMIO_BASE + 0x14 (read clears valid)
-// UART RX status register at MMIO_BASE + 0x18 (bit 0 = data available)
+// UART TX status register at MMIO_BASE + 0x04
+// UART RX data register at MMIO_BASE + 0x14 (read pops the RX FIFO)
+// UART RX status register at MMIO_BASE + 0x18
+// UART TX packed data register at MMIO_BASE + 0x1C (sw pushes 4 bytes)
+// UART baud divisor register at MMIO_BASE + 0x20 (clock cycles per bit)
 //
 #define UART_TX_OFFSET 0x00
 #define UART_TX_STATUS_OFFSET 0x04
 #define UART_RX_OFFSET 0x14
 #define UART_RX_STATUS_OFFSET 0x18
+#define UART_TX4_OFFSET 0x1C
+#define UART_BAUD_DIV_OFFSET 0x20
+
+//
+// Divisor limits (the receiver needs at least 4 clocks per bit)
+//
+#define UART_BAUD_DIV_MIN 4
+#define UART_BAUD_DIV_MAX 0xFFFF
+
+//
+// Convert a baud rate to a divisor
+//
+// Returns 0 and sets *div when the rate is reachable within 2.5%,
+// otherwise -1.
+//
+static int baud_to_div(uint32_t baud, uint32_t *div) {
+  uint32_t freq = svc_clock_freq();
+
+  if (baud == 0) {
+    return -1;
+  }
+
+  uint32_t d = (freq + (baud >> 1)) / baud;
+  if (d < UART_BAUD_DIV_MIN || d > UART_BAUD_DIV_MAX) {
+    return -1;
+  }
+
+  uint32_t actual = freq / d;
+  uint32_t err    = actual > baud ? actual - baud : baud - actual;
+  if (err * 40 > baud) {
+    return -1;
+  }
+
+  *div = d;
+  return 0;
+}
+
+//
+// Status register fields
+//
+// TX status: bit 0 = FIFO not full, bit 1 = idle, bits 15:8 = free entries
+// RX status: bit 0 = data available, bits 15:8 = FIFO level
+//
+#define UART_STATUS_READY 0x1
+#define UART_STATUS_IDLE 0x2
+#define UART_STATUS_COUNT(s) (((s) >> 8) & 0xFF)
+
+#if (SVC_UART_TX_RING_SIZE & (SVC_UART_TX_RING_SIZE - 1)) != 0
+#error "SVC_UART_TX_RING_SIZE must be a power of two"
+#endif
+
+#define TX_RING_MASK (SVC_UART_TX_RING_SIZE - 1)
+
+//
+// TX ring
+//
+// Free-running indices: head - tail is the number of queued bytes. Only
+// the foreground touches these (no interrupts), so no locking is needed.
+//
+static char     tx_ring[SVC_UART_TX_RING_SIZE];
+static uint32_t tx_head;
+static uint32_t tx_tail;
 
 //
 // Check if UART TX is busy
 //
 int svc_uart_tx_busy(void) {
   // TX is busy if ready bit (bit 0) is 0
-  return (mmio_read(UART_TX_STATUS_OFFSET) & 0x1) == 0;
+  return (mmio_read(UART_TX_STATUS_OFFSET) & UART_STATUS_READY) == 0;
+}
+
+//
+// Move queued bytes from the TX ring to the UART
+//
+// One status read tells how much room the TX FIFO has. Whole words go
+// through the packed register (one store per 4 bytes), the tail goes out a
+// byte at a time.
+//
+int svc_uart_poll(void) {
+  uint32_t queued = tx_head - tx_tail;
+
+  if (queued == 0) {
+    return 0;
+  }
+
+  uint32_t room = UART_STATUS_COUNT(mmio_read(UART_TX_STATUS_OFFSET));
+  uint32_t n    = queued < room ? queued : room;
+
+  for (; n >= 4; n -= 4) {
+    uint32_t word = (uint8_t)tx_ring[tx_tail & TX_RING_MASK];
+    word |= (uint32_t)(uint8_t)tx_ring[(tx_tail + 1) & TX_RING_MASK] << 8;
+    word |= (uint32_t)(uint8_t)tx_ring[(tx_tail + 2) & TX_RING_MASK] << 16;
+    word |= (uint32_t)(uint8_t)tx_ring[(tx_tail + 3) & TX_RING_MASK] << 24;
+    mmio_write(UART_TX4_OFFSET, word);
+    tx_tail += 4;
+  }
+
+  for (; n > 0; n--) {
+    mmio_write(UART_TX_OFFSET, (uint8_t)tx_ring[tx_tail & TX_RING_MASK]);
+    tx_tail++;
+  }
+
+  return (int)(tx_head - tx_tail);
+}
+
+//
+// Wait until the TX ring is empty
+//
+static void tx_ring_drain(void) {
+  while (svc_uart_poll() != 0) {
+    // Busy wait
+  }
+}
+
+//
+// Queue bytes for transmission
+//
+size_t svc_uart_write(const void *buf, size_t len) {
+  const char *p    = (const char *)buf;
+  size_t      room = SVC_UART_TX_RING_SIZE - (tx_head - tx_tail);
+  size_t      n    = len < room ? len : room;
+
+  for (size_t i = 0; i < n; i++) {
+    tx_ring[tx_head & TX_RING_MASK] = p[i];
+    tx_head++;
+  }
+
+  svc_uart_poll();
+  return n;
 }
 
 //
 // Send a single character via UART
 //
 void svc_uart_putc(char c) {
+  // Keep ordering with queued output
+  tx_ring_drain();
+
   // Wait until UART TX is ready
   while (svc_uart_tx_busy()) {
     // Busy wait
@@ -52,7 +183,9 @@ void svc_uart_puts(const char *s) {
 // Wait for UART TX to finish transmitting
 //
 void svc_uart_flush(void) {
-  while (svc_uart_tx_busy())
+  tx_ring_drain();
+
+  while ((mmio_read(UART_TX_STATUS_OFFSET) & UART_STATUS_IDLE) == 0)
     ;
 }
 
@@ -60,16 +193,31 @@ void svc_uart_flush(void) {
 // Check if UART RX has data available
 //
 int svc_uart_rx_ready(void) {
-  return (mmio_read(UART_RX_STATUS_OFFSET) & 0x1) != 0;
+  return (mmio_read(UART_RX_STATUS_OFFSET) & UART_STATUS_READY) != 0;
+}
+
+//
+// Receive available bytes (non-blocking)
+//
+size_t svc_uart_read(void *buf, size_t len) {
+  char  *p     = (char *)buf;
+  size_t avail = UART_STATUS_COUNT(mmio_read(UART_RX_STATUS_OFFSET));
+  size_t n     = len < avail ? len : avail;
+
+  for (size_t i = 0; i < n; i++) {
+    p[i] = (char)(mmio_read(UART_RX_OFFSET) & 0xFF);
+  }
+
+  return n;
 }
 
 //
 // Receive a single character via UART (blocking)
 //
 char svc_uart_getc(void) {
-  // Wait until data is available
+  // Wait until data is available, draining output meanwhile
   while (!svc_uart_rx_ready()) {
-    // Busy wait
+    svc_uart_poll();
   }
 
   // Read and return the character (read clears valid)
@@ -80,6 +228,8 @@ char svc_uart_getc(void) {
 // Receive a single character via UART (non-blocking)
 //
 int svc_uart_getc_nb(void) {
+  svc_uart_poll();
+
   if (!svc_uart_rx_ready()) {
     return -1;
   }
@@ -88,6 +238,104 @@ int svc_uart_getc_nb(void) {
   return (int)(mmio_read(UART_RX_OFFSET) & 0xFF);
 }
 
+//
+// Change the UART baud rate
+//
+int svc_uart_set_baud(uint32_t baud) {
+  uint32_t div;
+
+  if (baud_to_div(baud, &div) != 0) {
+    return -1;
+  }
+
+  // Don't change the bit period under a byte in flight
+  svc_uart_flush();
+  mmio_write(UART_BAUD_DIV_OFFSET, div);
+
+  return 0;
+}
+
+//
+// Get the current UART baud rate
+//
+uint32_t svc_uart_get_baud(void) {
+  uint32_t div = mmio_read(UART_BAUD_DIV_OFFSET) & 0xFFFF;
+
+  return div ? svc_clock_freq() / div : 0;
+}
+
+//
+// Baud handshake
+//
+// DLE starts a line the host console reads as a request rather than
+// program output. ACK is the host's only reply.
+//
+#define BAUD_DLE 0x10
+#define BAUD_ACK 0x06
+
+//
+// Time for the host to reprogram its port after ACK (ms)
+//
+#define BAUD_GUARD_MS 20
+
+//
+// Copy a string and return the end of the copy
+//
+static char *append(char *dst, const char *src) {
+  while (*src) {
+    *dst++ = *src++;
+  }
+  return dst;
+}
+
+//
+// Switch to a new baud rate with the host's agreement
+//
+int svc_uart_negotiate_baud(uint32_t baud, uint32_t timeout_ms) {
+  char     msg[32 + 2 * SVC_UTOA_BUF_SIZE];
+  char    *p = msg;
+  uint32_t div;
+
+  if (baud_to_div(baud, &div) != 0) {
+    return -1;
+  }
+
+  // Drop stale input so only a reply to this request counts
+  while (svc_uart_getc_nb() >= 0) {
+  }
+
+  *p++ = BAUD_DLE;
+  p    = append(p, "SVC-BAUD ");
+  p   += svc_utoa(baud, p);
+  *p++ = ' ';
+  p   += svc_utoa(div, p);
+  *p++ = '\n';
+  svc_uart_write(msg, p - msg);
+  svc_uart_flush();
+
+  uint32_t ticks = svc_clock_freq() / 1000;
+  uint32_t start = rdcycle();
+
+  while (svc_uart_getc_nb() != BAUD_ACK) {
+    if (rdcycle() - start >= ticks * timeout_ms) {
+      return -1;
+    }
+  }
+
+  // Let the host reprogram its port, then confirm at the new rate
+  start = rdcycle();
+  while (rdcycle() - start < ticks * BAUD_GUARD_MS) {
+  }
+  mmio_write(UART_BAUD_DIV_OFFSET, div);
+
+  p    = msg;
+  *p++ = BAUD_DLE;
+  p    = append(p, "SVC-BAUD OK\n");
+  svc_uart_write(msg, p - msg);
+
+  return 0;
+}
+
 #else  // SVC_DISABLE_MMIO
 
 //
@@ -106,6 +354,15 @@ void svc_uart_puts(const char *s) {
   (void)s;
 }
 
+size_t svc_uart_write(const void *buf, size_t len) {
+  (void)buf;
+  return len;
+}
+
+int svc_uart_poll(void) {
+  return 0;
+}
+
 void svc_uart_flush(void) {
 }
 
@@ -113,6 +370,12 @@ int svc_uart_rx_ready(void) {
   return 0;
 }
 
+size_t svc_uart_read(void *buf, size_t len) {
+  (void)buf;
+  (void)len;
+  return 0;
+}
+
 char svc_uart_getc(void) {
   return 0;
 }
@@ -121,4 +384,19 @@ int svc_uart_getc_nb(void) {
   return 0;
 }
 
+int svc_uart_set_baud(uint32_t baud) {
+  (void)baud;
+  return 0;
+}
+
+uint32_t svc_uart_get_baud(void) {
+  return 0;
+}
+
+int svc_uart_negotiate_baud(uint32_t baud, uint32_t timeout_ms) {
+  (void)baud;
+  (void)timeout_ms;
+  return -1;
+}
+
 #endif  // SVC_DISABLE_MMIO
@@ -1,17 +1,40 @@
 #ifndef LIBSVC_UART_H
 #define LIBSVC_UART_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 //
 // UART Hardware Layer
 //
 // Low-level UART I/O functions for SVC RISC-V SoC
 //
+// Output can go through a software TX ring: svc_uart_write() queues bytes
+// and returns, and the ring drains whenever libsvc gets control
+// (svc_uart_write, svc_uart_poll, or any blocking UART call). There are no
+// interrupts, so programs that compute for long stretches should call
+// svc_uart_poll() from their main loop to keep the line busy.
+//
+// The blocking calls drain the ring first, so output stays in order no
+// matter which API wrote it.
+//
+// The UART has hardware TX and RX FIFOs with fill levels in the status
+// registers, so the ring drains in bursts (4 bytes per store) and received
+// bytes wait in the RX FIFO until software gets to them.
+//
+
+//
+// TX ring size in bytes (power of two)
+//
+#ifndef SVC_UART_TX_RING_SIZE
+#define SVC_UART_TX_RING_SIZE 256
+#endif
 
 //
 // Check if UART TX is busy
 //
 // Returns:
-//   1 if TX is busy (not ready to accept a new character)
+//   1 if TX is busy (FIFO full, not ready to accept a new character)
 //   0 if TX is ready
 //
 int svc_uart_tx_busy(void);
@@ -19,8 +42,8 @@ int svc_uart_tx_busy(void);
 //
 // Send a single character via UART
 //
-// This is the foundational putchar function. It waits for the UART
-// TX to be ready, then writes the character.
+// This is the foundational putchar function. It drains the TX ring, waits
+// for the UART TX to be ready, then writes the character.
 //
 // Args:
 //   c: Character to transmit
@@ -35,10 +58,36 @@ void svc_uart_putc(char c);
 //
 void svc_uart_puts(const char *s);
 
+//
+// Queue bytes for transmission (non-blocking)
+//
+// Copies as much of buf as fits into the TX ring and starts transmission
+// if the UART is idle. Never waits for the UART.
+//
+// Args:
+//   buf: Bytes to transmit
+//   len: Number of bytes
+//
+// Returns:
+//   Number of bytes accepted (less than len only when the ring is full)
+//
+size_t svc_uart_write(const void *buf, size_t len);
+
+//
+// Move queued bytes from the TX ring to the UART (non-blocking)
+//
+// Sends as many bytes as the UART will take right now and returns.
+// Cheap when the ring is empty, so it can be called freely from loops.
+//
+// Returns:
+//   Number of bytes still queued
+//
+int svc_uart_poll(void);
+
 //
 // Wait for UART TX to finish transmitting
 //
-// After writing the last character, wait for it to finish
+// Drains the TX ring, then waits for the last character to finish
 // transmitting over the serial line before proceeding.
 //
 void svc_uart_flush(void);
@@ -52,10 +101,23 @@ void svc_uart_flush(void);
 //
 int svc_uart_rx_ready(void);
 
+//
+// Receive the bytes already waiting in the RX FIFO (non-blocking)
+//
+// Args:
+//   buf: Destination buffer
+//   len: Maximum number of bytes to read
+//
+// Returns:
+//   Number of bytes read (0 if none are waiting)
+//
+size_t svc_uart_read(void *buf, size_t len);
+
 //
 // Receive a single character via UART (blocking)
 //
-// Waits until a character is available, then returns it.
+// Waits until a character is available, then returns it. Queued output
+// keeps draining while waiting, so prompts are visible before input.
 //
 // Returns:
 //   The received character
@@ -72,4 +134,49 @@ char svc_uart_getc(void);
 //
 int svc_uart_getc_nb(void);
 
+//
+// Change the UART baud rate
+//
+// Drains pending output, then programs the divisor for the requested rate
+// from svc_clock_freq(). Whatever is on the other end of the line has to
+// switch too; use svc_uart_negotiate_baud() when that is a host tool.
+//
+// Args:
+//   baud: New rate in bits per second
+//
+// Returns:
+//   0 on success, -1 if the clock can't produce the rate within 2.5%
+//
+int svc_uart_set_baud(uint32_t baud);
+
+//
+// Get the current UART baud rate
+//
+// Returns:
+//   Rate in bits per second as produced by the current divisor
+//
+uint32_t svc_uart_get_baud(void);
+
+//
+// Switch baud rate with the host console's agreement
+//
+// Handshake (host side: scripts/rv_loader --console):
+//   1. Target sends "\x10SVC-BAUD <rate> <div>\n" at the current rate,
+//      with the divisor it is about to program
+//   2. Host replies ACK (0x06) and reprograms its port to the rate
+//   3. Target waits 20 ms, programs the divisor, and sends
+//      "\x10SVC-BAUD OK\n" at the new rate
+//
+// The host console has to read the app UART and be able to reply on it.
+//
+// Args:
+//   baud:       New rate in bits per second
+//   timeout_ms: How long to wait for the ACK
+//
+// Returns:
+//   0 if both sides switched, -1 if the clock can't produce the rate or
+//   no ACK came in time (the rate is unchanged)
+//
+int svc_uart_negotiate_baud(uint32_t baud, uint32_t timeout_ms);
+
 #endif  // LIBSVC_UART_H
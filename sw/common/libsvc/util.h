@@ -29,4 +29,43 @@ void svc_halt(void) __attribute__((noreturn));
 //
 void svc_delay(uint32_t count);
 
+//
+// Count leading zero bits of a 32-bit value
+//
+// RV32I has no clz instruction and we don't link libgcc for __clzsi2,
+// so this is a 5-step binary search. Used to normalize operands in the
+// soft division routines.
+//
+// Args:
+//   x: Value to scan (must be non-zero)
+//
+// Returns:
+//   Number of leading zero bits (0-31)
+//
+static inline uint32_t svc_clz32(uint32_t x) {
+  uint32_t n = 0;
+
+  if (x <= 0x0000FFFFu) {
+    n += 16;
+    x <<= 16;
+  }
+  if (x <= 0x00FFFFFFu) {
+    n += 8;
+    x <<= 8;
+  }
+  if (x <= 0x0FFFFFFFu) {
+    n += 4;
+    x <<= 4;
+  }
+  if (x <= 0x3FFFFFFFu) {
+    n += 2;
+    x <<= 2;
+  }
+  if (x <= 0x7FFFFFFFu) {
+    n += 1;
+  }
+
+  return n;
+}
+
 #endif  // LIBSVC_UTIL_H
@@ -11,6 +11,7 @@
 #include <unistd.h>
 
 #include "libsvc/csr.h"
+#include "libsvc/divmod.h"
 #include "libsvc/sys.h"
 #include "libsvc/uart.h"
 
@@ -18,6 +19,12 @@
 extern char __heap_start;
 extern char __heap_end;
 
+// Highest break handed out, for svc_mem_stats()
+char *__heap_peak = &__heap_start;
+
+// Linked only when the program sets SVC_MEM_REPORT
+extern void svc_mem_report(void) __attribute__((weak));
+
 //
 // Write to file descriptor (UART for stdout/stderr)
 //
@@ -27,9 +34,15 @@ ssize_t write(int fd, const void *buf, size_t count) {
     return -1;
   }
 
-  const char *p = (const char *)buf;
-  for (size_t i = 0; i < count; i++) {
-    svc_uart_putc(p[i]);
+  //
+  // Queue through the TX ring so the caller can get back to work while the
+  // UART shifts bytes out. Only blocks while the ring is full.
+  //
+  const char *p    = (const char *)buf;
+  size_t      done = 0;
+
+  while (done < count) {
+    done += svc_uart_write(p + done, count - done);
   }
 
   return (ssize_t)count;
@@ -71,6 +84,10 @@ void *sbrk(ptrdiff_t incr) {
   }
 
   heap_ptr = new_heap;
+  if (new_heap > __heap_peak) {
+    __heap_peak = new_heap;
+  }
+
   return prev_heap;
 }
 
@@ -122,6 +139,13 @@ int isatty(int fd) {
 //
 void _exit(int status) {
   (void)status;
+  if (svc_mem_report) {
+    svc_mem_report();
+  }
+#ifdef SVC_EXIT_EOT
+  // Tell a host console (rv_loader --console) the program is done
+  svc_uart_putc(0x04);
+#endif
   // Flush any pending output
   svc_uart_flush();
   // Halt - infinite loop
@@ -148,10 +172,10 @@ pid_t getpid(void) {
 }
 
 //
-// Get time of day (stub - returns 0)
+// Get time of day
 //
-// Note: RV32I has no hardware division, and we don't link libgcc.
-// A proper implementation would need soft division routines.
+// Time since reset, derived from the cycle counter and the hardware clock
+// frequency. The 64-bit division goes through the libsvc soft runtime.
 //
 int gettimeofday(struct timeval *tv, void *tz) {
   (void)tz;
@@ -161,8 +185,20 @@ int gettimeofday(struct timeval *tv, void *tz) {
     return -1;
   }
 
-  tv->tv_sec  = 0;
-  tv->tv_usec = 0;
+  uint64_t cycles = read_cycles();
+  uint32_t freq   = svc_clock_freq();
+
+  if (freq == 0) {
+    tv->tv_sec  = 0;
+    tv->tv_usec = 0;
+    return 0;
+  }
+
+  uint64_t rem;
+  uint64_t sec = __udivmoddi4(cycles, freq, &rem);
+
+  tv->tv_sec  = (time_t)sec;
+  tv->tv_usec = (rem * 1000000u) / freq;
 
   return 0;
 }
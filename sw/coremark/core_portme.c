@@ -2,11 +2,11 @@
  * CoreMark port for svc-example RISC-V bare-metal environment
  */
 #include <stdarg.h>
-#include <stdio.h>
 
 #include "core_portme.h"
 #include "coremark.h"
 #include "libsvc/csr.h"
+#include "libsvc/fmt.h"
 #include "libsvc/sys.h"
 
 /* Volatile seeds for CoreMark */
@@ -49,19 +49,32 @@ static CORETIMETYPE start_time_val, stop_time_val;
 /* Saved for final report */
 static uint32_t saved_iterations = 0;
 
+/* Stall attribution counters over the timed region */
+static uint32_t stall_cycles[SVC_PERF_NUM_EVENTS];
+static const char *const stall_names[SVC_PERF_NUM_EVENTS] = {
+    "load-use", "mispredict", "BTB miss",    "RAS miss",
+    "I-cache",  "D-cache",    "memory wait",
+};
+
 /* Number of contexts (single-threaded) */
 ee_u32 default_num_contexts = 1;
 
 /*
  * Start timing measurement
  */
-void start_time(void) { GETMYTIME(&start_time_val); }
+void start_time(void) {
+  svc_perf_reset();
+  GETMYTIME(&start_time_val);
+}
 
 /*
  * Stop timing measurement
  */
 void stop_time(void) {
   GETMYTIME(&stop_time_val);
+  for (int i = 0; i < SVC_PERF_NUM_EVENTS; i++) {
+    stall_cycles[i] = svc_perf_read(i);
+  }
   /* Save iterations for final report - seed4_volatile holds ITERATIONS */
   saved_iterations = (uint32_t)seed4_volatile;
 }
@@ -124,6 +137,30 @@ void portable_init(core_portable *p, int *argc, char *argv[]) {
   p->portable_id = 1;
 }
 
+/*
+ * Print the stall attribution counters as cycles and share of the run
+ *
+ * Skipped when every counter is 0 (core without stall events).
+ */
+static void print_stalls(CORE_TICKS elapsed) {
+  uint32_t total = 0;
+
+  for (int i = 0; i < SVC_PERF_NUM_EVENTS; i++) {
+    total += stall_cycles[i];
+  }
+  if (total == 0 || elapsed == 0) {
+    return;
+  }
+
+  ee_printf("\nStall attribution:\n");
+  for (int i = 0; i < SVC_PERF_NUM_EVENTS; i++) {
+    uint32_t pct_x100 =
+        (uint32_t)(((uint64_t)stall_cycles[i] * 10000u) / elapsed);
+    ee_printf("  %-12s: %10u cycles %3u.%02u%%\n", stall_names[i],
+              stall_cycles[i], pct_x100 / 100, pct_x100 % 100);
+  }
+}
+
 /*
  * Target-specific cleanup
  *
@@ -152,14 +189,11 @@ void portable_fini(core_portable *p) {
      * For 100 iterations with ~400M cycles:
      * = 100 * 100000000 / 400000000 = 25 (i.e., 0.25 CM/MHz)
      *
-     * To avoid 64-bit division, we can do this in steps using 32-bit ops
-     * since elapsed >> iterations typically.
-     *
-     * elapsed_per_iter = elapsed / iterations
-     * cm_mhz_x100 = 100000000 / elapsed_per_iter
+     * iterations * 100000000 overflows 32 bits, so use 64-bit math (the
+     * libsvc runtime provides the 64-bit divide on every RV32 variant).
      */
-    uint32_t elapsed_per_iter = elapsed / saved_iterations;
-    uint32_t cm_mhz_x100 = 100000000 / elapsed_per_iter;
+    uint32_t cm_mhz_x100 =
+        (uint32_t)(((uint64_t)saved_iterations * 100000000u) / elapsed);
     uint32_t cm_mhz_int = cm_mhz_x100 / 100;
     uint32_t cm_mhz_frac = cm_mhz_x100 % 100;
 
@@ -168,17 +202,21 @@ void portable_fini(core_portable *p) {
     ee_printf("Clock frequency  : %d MHz\n", mhz);
 #endif
     ee_printf("CoreMark/MHz     : %d.%02d\n", cm_mhz_int, cm_mhz_frac);
+
+    print_stalls(elapsed);
   }
 }
 
 /*
- * ee_printf - wrapper around libsvc vprintf
- * CoreMark requires this function even when HAS_PRINTF=1
+ * ee_printf - wrapper around libsvc svc_vprintf
+ * CoreMark requires this function even when HAS_PRINTF=1. svc_vprintf
+ * formats integers without __udivsi3/__umodsi3, which keeps reporting
+ * cheap on rv32i. CoreMark only uses %d/%u/%x/%s (HAS_FLOAT=0).
  */
 int ee_printf(const char *fmt, ...) {
   va_list args;
   va_start(args, fmt);
-  int ret = vprintf(fmt, args);
+  int ret = svc_vprintf(fmt, args);
   va_end(args);
   return ret;
 }
@@ -1,27 +1,62 @@
 #include <stdio.h>
 
+#include "libsvc/csr.h"
 #include "libsvc/uart.h"
 
+//
+// Echo with toupper
+//
+// Takes whatever has arrived in the RX FIFO in one go and queues the reply
+// through the TX ring, so a pasted burst costs a handful of MMIO accesses
+// per FIFO's worth of bytes instead of a status poll per byte. Ends on ^D
+// and reports the throughput.
+//
 int main(void) {
-  char c;
+  char     buf[32];
+  uint32_t bytes = 0;
+  uint32_t start = 0;
+  int      done  = 0;
 
   printf("Echo with toupper:\n");
 
-  while (1) {
-    c = svc_uart_getc();
+  while (!done) {
+    size_t n = svc_uart_read(buf, sizeof(buf));
 
-    // Uppercase if lowercase to prove C code processed it
-    if (c >= 'a' && c <= 'z') {
-      c = c - 'a' + 'A';
+    if (n == 0) {
+      svc_uart_poll();
+      continue;
     }
 
-    svc_uart_putc(c);
+    if (bytes == 0) {
+      start = rdcycle();
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      char c = buf[i];
 
-    if (c == 0x04) {
-      break;
+      // Uppercase if lowercase to prove C code processed it
+      if (c >= 'a' && c <= 'z') {
+        buf[i] = c - 'a' + 'A';
+      }
+
+      if (c == 0x04) {
+        n    = i + 1;
+        done = 1;
+        break;
+      }
+    }
+
+    bytes += n;
+
+    size_t sent = 0;
+    while (sent < n) {
+      sent += svc_uart_write(buf + sent, n - sent);
     }
   }
 
+  uint32_t cycles = rdcycle() - start;
+
   printf("\n");
+  printf("Echoed %u bytes in %u cycles\n", (unsigned)bytes, (unsigned)cycles);
   return 0;
 }
@@ -1,6 +1,8 @@
 #ifndef LIB_TEST_H
 #define LIB_TEST_H
 
+#include <stdint.h>
+
 //
 // Test function prototypes for libsvc infrastructure testing
 //
@@ -10,6 +12,21 @@ void test_string(void);
 void test_malloc(void);
 void test_combined(void);
 void test_divmod(void);
+void test_divisor(void);
+void test_mul(void);
 void test_printf(void);
+void test_uart(void);
+
+//
+// Simple xorshift PRNG for reproducible operands
+//
+static inline uint32_t xorshift32(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
 
 #endif  // LIB_TEST_H
@@ -17,7 +17,10 @@ int main(void) {
   test_malloc();
   test_combined();
   test_divmod();
+  test_divisor();
+  test_mul();
   test_printf();
+  test_uart();
 
   puts("");
   puts("=== All tests complete ===");
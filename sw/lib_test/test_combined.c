@@ -1,35 +1,85 @@
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "libsvc/arena.h"
 #include "libsvc/csr.h"
 #include "lib_test.h"
 
 //
 // Combined test using all infrastructure together
 //
-// Creates a linked list using malloc, fills it with data using string
-// functions, and times the whole operation using CSR counters. This
-// validates that all pieces work together correctly before Dhrystone.
+// Creates a linked list, fills it with data using string functions, and
+// times the whole operation using CSR counters. This validates that all
+// pieces work together correctly before Dhrystone.
 //
+// The list is built twice: node by node with malloc, and from a libsvc
+// arena, which is how programs that never free nodes individually should
+// allocate them. Cycles and the memory spanned by the nodes are reported
+// for both.
+//
+
+#define NUM_NODES 10
 
 typedef struct Node {
   int data;
   struct Node* next;
 } Node;
 
+typedef struct {
+  int      sum;
+  uint32_t cycles;
+  uint32_t span;
+} ListResult;
+
+static uint8_t arena_buf[NUM_NODES * sizeof(Node) + 64]
+    __attribute__((aligned(SVC_ARENA_ALIGN)));
+
+//
+// Sum the list and measure the address range its nodes occupy
+//
+static void walk_list(Node* head, ListResult* r) {
+  uintptr_t lo = UINTPTR_MAX;
+  uintptr_t hi = 0;
+
+  r->sum = 0;
+  for (Node* n = head; n != NULL; n = n->next) {
+    r->sum += n->data;
+    if ((uintptr_t)n < lo) {
+      lo = (uintptr_t)n;
+    }
+    if ((uintptr_t)n + sizeof(Node) > hi) {
+      hi = (uintptr_t)n + sizeof(Node);
+    }
+  }
+
+  r->span = (uint32_t)(hi - lo);
+}
+
+static void report(const char* label, const ListResult* r) {
+  printf("%s: sum %d, %u cycles, %u bytes spanned (%s)\n", label, r->sum,
+         (unsigned)r->cycles, (unsigned)r->span,
+         r->sum == 45 ? "PASS" : "FAIL");
+}
+
 void test_combined(void) {
   printf("\n-- Combined Test --\n");
 
+  ListResult heap;
+  ListResult arena;
+
+  //
+  // malloc: one allocation per node
+  //
   uint64_t start = read_cycles();
 
-  // Allocate linked list
   Node* head = malloc(sizeof(Node));
   Node* current = head;
 
-  for (int i = 0; i < 10; i++) {
+  for (int i = 0; i < NUM_NODES; i++) {
     current->data = i;
-    if (i < 9) {
+    if (i < NUM_NODES - 1) {
       current->next = malloc(sizeof(Node));
       current = current->next;
     } else {
@@ -37,27 +87,55 @@ void test_combined(void) {
     }
   }
 
-  // Traverse and sum
-  int sum = 0;
-  current = head;
-  while (current) {
-    sum += current->data;
-    current = current->next;
+  walk_list(head, &heap);
+  heap.cycles = (uint32_t)(read_cycles() - start);
+
+  while (head != NULL) {
+    Node* next = head->next;
+    free(head);
+    head = next;
   }
 
-  uint64_t end = read_cycles();
+  //
+  // Arena: bump allocation, released all at once
+  //
+  svc_arena_t a;
+  svc_arena_init(&a, arena_buf, sizeof(arena_buf));
+
+  start = read_cycles();
 
-  printf("Sum: %d (expected 45)\n", sum);
-  printf("Cycles: %u\n", (unsigned int)(end - start));
+  head = SVC_ARENA_NEW(&a, Node);
+  current = head;
 
-  if (sum == 45) {
-    printf("Combined test: PASS\n");
-  } else {
-    printf("Combined test: FAIL\n");
+  for (int i = 0; i < NUM_NODES; i++) {
+    current->data = i;
+    if (i < NUM_NODES - 1) {
+      current->next = SVC_ARENA_NEW(&a, Node);
+      current = current->next;
+    } else {
+      current->next = NULL;
+    }
   }
 
-  // String test
-  char buf[32];
+  walk_list(head, &arena);
+  arena.cycles = (uint32_t)(read_cycles() - start);
+
+  report("malloc list", &heap);
+  report("arena list ", &arena);
+  printf("Arena used: %u bytes for %u of payload (%s)\n",
+         (unsigned)svc_arena_used(&a), (unsigned)(NUM_NODES * sizeof(Node)),
+         svc_arena_used(&a) == NUM_NODES * sizeof(Node) ? "PASS" : "FAIL");
+
+  // String test, with a scratch buffer that is rewound afterwards
+  svc_arena_mark_t mark = svc_arena_mark(&a);
+
+  char* buf = svc_arena_alloc(&a, 32);
   strcpy(buf, "Success!");
   printf("Result: %s\n", buf);
+
+  svc_arena_rewind(&a, mark);
+  printf("Rewind: %u bytes used (%s)\n", (unsigned)svc_arena_used(&a),
+         svc_arena_used(&a) == NUM_NODES * sizeof(Node) ? "PASS" : "FAIL");
+
+  svc_arena_reset(&a);
 }
@@ -1,8 +1,65 @@
 #include <stdio.h>
 
+#include "libsvc/ckpt.h"
 #include "libsvc/csr.h"
+#include "libsvc/prof.h"
 #include "lib_test.h"
 
+SVC_PROF_ZONE(z_empty, "empty");
+SVC_PROF_ZONE(z_outer, "nop outer");
+SVC_PROF_ZONE(z_inner, "nop inner");
+
+static void nops(int n) {
+  for (int i = 0; i < n; i++) {
+    asm volatile("nop");
+  }
+}
+
+//
+// Profiling zones: an empty zone should cost ~nothing once the overhead
+// is subtracted, and a parent's self time should exclude its child
+//
+static void test_prof(void) {
+  for (int i = 0; i < 16; i++) {
+    SVC_PROF_ENTER(z_empty);
+    SVC_PROF_EXIT(z_empty);
+  }
+
+  for (int i = 0; i < 4; i++) {
+    SVC_PROF_ENTER(z_outer);
+    nops(100);
+    SVC_PROF_ENTER(z_inner);
+    nops(200);
+    SVC_PROF_EXIT(z_inner);
+    SVC_PROF_EXIT(z_outer);
+  }
+
+  svc_prof_dump();
+
+  uint32_t empty_avg = (uint32_t)z_empty.cycles / z_empty.calls;
+  printf("Prof empty zone: %u cycles/call (%s)\n", (unsigned)empty_avg,
+         empty_avg <= 2 ? "PASS" : "FAIL");
+
+  uint64_t split = z_outer.self_cycles + z_inner.cycles;
+  printf("Prof nesting: self + child == total (%s)\n",
+         split == z_outer.cycles ? "PASS" : "FAIL");
+  printf("Prof errors: %u (%s)\n", (unsigned)svc_prof_errors(),
+         svc_prof_errors() == 0 ? "PASS" : "FAIL");
+}
+
+//
+// Checkpoint: locals must survive the save, and a plain run (no restore)
+// must not look resumed. A sim restored from this point reports resumed=1.
+//
+static void test_ckpt(void) {
+  volatile uint32_t marker = 0x5A5A1234;
+
+  SVC_CKPT();
+
+  printf("Ckpt: resumed=%u (%s)\n", (unsigned)svc_ckpt_resumed(),
+         marker == 0x5A5A1234 ? "PASS" : "FAIL");
+}
+
 //
 // Test CSR cycle counter functionality
 //
@@ -10,6 +67,8 @@
 // - rdcycle instructions work
 // - Cycle counter increments as expected
 // - 64-bit atomic read handles potential rollover
+// - profiling zones subtract their own overhead and handle nesting
+// - a checkpoint returns with the caller's locals intact
 //
 void test_csr(void) {
   printf("-- CSR Test --\n");
@@ -26,4 +85,7 @@ void test_csr(void) {
 
   printf("Cycles elapsed: %u\n", elapsed);
   printf("Expected > 1000, got %s\n", elapsed > 1000 ? "PASS" : "FAIL");
+
+  test_prof();
+  test_ckpt();
 }
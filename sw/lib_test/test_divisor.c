@@ -0,0 +1,131 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#include "libsvc/csr.h"
+#include "libsvc/divisor.h"
+#include "libsvc/divmod.h"
+#include "lib_test.h"
+
+//
+// Test precomputed invariant divisors
+//
+// Verifies that svc_divisor_div/divmod match __udivmodsi4 exactly for
+// edge-case divisors and dividends, then reports the cycles saved against
+// __udivsi3 for divisors typical of our firmware.
+//
+
+#define BENCH_N 16
+
+static const uint32_t edge_divisors[] = {
+    1,          2,          3,          7,          10,
+    60,         1000,       115200,     1000000,    25000000,
+    0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFFFFFE, 0xFFFFFFFF,
+};
+
+//
+// Check one divisor against __udivmodsi4 for edge and pseudo-random dividends
+//
+// Returns the number of mismatches.
+//
+static int check_divisor(uint32_t divisor, uint32_t *seed) {
+  uint32_t edge[] = {0,           1,          divisor - 1, divisor,
+                     divisor + 1, 0x7FFFFFFF, 0x80000000,  0xFFFFFFFE,
+                     0xFFFFFFFF};
+  int      errors = 0;
+
+  svc_divisor_t d;
+  svc_divisor_init(&d, divisor);
+
+  for (unsigned i = 0; i < sizeof(edge) / sizeof(edge[0]) + 32; i++) {
+    uint32_t n;
+
+    if (i < sizeof(edge) / sizeof(edge[0])) {
+      n = edge[i];
+    } else {
+      n = xorshift32(seed);
+    }
+
+    uint32_t exp_r;
+    uint32_t exp_q = __udivmodsi4(n, divisor, &exp_r);
+    uint32_t r;
+    uint32_t q = svc_divisor_divmod(&d, n, &r);
+
+    if (q != exp_q || r != exp_r || svc_divisor_div(&d, n) != exp_q) {
+      printf("  FAIL: %u / %u = %u rem %u (expected %u rem %u)\n",
+             (unsigned)n, (unsigned)divisor, (unsigned)q, (unsigned)r,
+             (unsigned)exp_q, (unsigned)exp_r);
+      errors++;
+    }
+  }
+
+  return errors;
+}
+
+//
+// Time BENCH_N divisions through __udivsi3 and svc_divisor_div
+//
+static void bench_divisor(uint32_t divisor, uint32_t *seed) {
+  uint32_t n[BENCH_N];
+  uint32_t q_soft[BENCH_N];
+  uint32_t q_fast[BENCH_N];
+
+  for (int i = 0; i < BENCH_N; i++) {
+    n[i] = xorshift32(seed);
+  }
+
+  uint32_t start = rdcycle();
+  for (int i = 0; i < BENCH_N; i++) {
+    q_soft[i] = __udivsi3(n[i], divisor);
+  }
+  uint32_t soft_cycles = rdcycle() - start;
+
+  svc_divisor_t d;
+  start = rdcycle();
+  svc_divisor_init(&d, divisor);
+  uint32_t init_cycles = rdcycle() - start;
+
+  start = rdcycle();
+  for (int i = 0; i < BENCH_N; i++) {
+    q_fast[i] = svc_divisor_div(&d, n[i]);
+  }
+  uint32_t fast_cycles = rdcycle() - start;
+
+  int match = 1;
+  for (int i = 0; i < BENCH_N; i++) {
+    match &= (q_soft[i] == q_fast[i]);
+  }
+
+  printf("  /%-9u: udivsi3 %4u fast %4u cyc/div (init %u) %s\n",
+         (unsigned)divisor, (unsigned)(soft_cycles / BENCH_N),
+         (unsigned)(fast_cycles / BENCH_N), (unsigned)init_cycles,
+         match ? "PASS" : "FAIL");
+}
+
+void test_divisor(void) {
+  printf("\n-- Divisor Test --\n");
+
+  uint32_t seed   = 0xC0FFEE11;
+  int      errors = 0;
+
+  for (unsigned i = 0; i < sizeof(edge_divisors) / sizeof(edge_divisors[0]);
+       i++) {
+    errors += check_divisor(edge_divisors[i], &seed);
+  }
+  printf("Exactness: %d errors (%s)\n", errors, errors == 0 ? "PASS" : "FAIL");
+
+  // Divide by zero follows the __udivsi3 fallback
+  svc_divisor_t zero;
+  uint32_t      zero_r;
+  svc_divisor_init(&zero, 0);
+  uint32_t zero_q = svc_divisor_divmod(&zero, 1234, &zero_r);
+  printf("Divide by zero: %u rem %u (%s)\n", (unsigned)zero_q,
+         (unsigned)zero_r, zero_q == 0 && zero_r == 0 ? "PASS" : "FAIL");
+
+  printf("Divisor benchmark (avg of %d, 32-bit dividends):\n", BENCH_N);
+  bench_divisor(10, &seed);
+  bench_divisor(1000, &seed);
+  bench_divisor(1000000, &seed);
+  bench_divisor(7, &seed);
+
+  printf("Divisor tests complete\n");
+}
@@ -1,5 +1,8 @@
+#include <stdint.h>
 #include <stdio.h>
 
+#include "libsvc/csr.h"
+#include "libsvc/divmod.h"
 #include "lib_test.h"
 
 //
@@ -10,6 +13,131 @@
 // - Unsigned division
 // - Division required by Dhrystone
 //
+// Then benchmarks the libsvc routine against the original fixed 32-iteration
+// long division across a sweep of dividend/divisor widths.
+//
+
+#define BENCH_N 16
+
+//
+// Reference: the original bit-serial long division (always 32 iterations)
+//
+static uint32_t __attribute__((noinline))
+ref_udivmod(uint32_t dividend, uint32_t divisor, uint32_t *rem) {
+  uint32_t quotient  = 0;
+  uint32_t remainder = 0;
+
+  if (divisor == 0) {
+    *rem = 0;
+    return 0;
+  }
+
+  for (int i = 31; i >= 0; i--) {
+    remainder = (remainder << 1) | ((dividend >> i) & 1);
+    if (remainder >= divisor) {
+      remainder -= divisor;
+      quotient |= (1u << i);
+    }
+  }
+
+  *rem = remainder;
+  return quotient;
+}
+
+//
+// Random operand with exactly the given number of significant bits
+//
+static uint32_t width_operand(uint32_t *seed, int bits) {
+  uint32_t x = xorshift32(seed);
+
+  if (bits < 32) {
+    x &= (1u << bits) - 1;
+  }
+
+  return x | (1u << (bits - 1));
+}
+
+//
+// Time BENCH_N divisions of each routine for one operand width pair
+//
+// Returns the number of results that disagree with the reference.
+//
+static int bench_widths(uint32_t *seed, int n_bits, int d_bits) {
+  uint32_t n[BENCH_N];
+  uint32_t d[BENCH_N];
+  uint32_t ref_q[BENCH_N];
+  uint32_t ref_r[BENCH_N];
+  uint32_t new_q[BENCH_N];
+  uint32_t new_r[BENCH_N];
+
+  for (int i = 0; i < BENCH_N; i++) {
+    n[i] = width_operand(seed, n_bits);
+    d[i] = width_operand(seed, d_bits);
+  }
+
+  uint32_t start = rdcycle();
+  for (int i = 0; i < BENCH_N; i++) {
+    ref_q[i] = ref_udivmod(n[i], d[i], &ref_r[i]);
+  }
+  uint32_t ref_cycles = rdcycle() - start;
+
+  start = rdcycle();
+  for (int i = 0; i < BENCH_N; i++) {
+    new_q[i] = __udivmodsi4(n[i], d[i], &new_r[i]);
+  }
+  uint32_t new_cycles = rdcycle() - start;
+
+  int errors = 0;
+  for (int i = 0; i < BENCH_N; i++) {
+    if (new_q[i] != ref_q[i] || new_r[i] != ref_r[i]) {
+      errors++;
+    }
+  }
+
+  printf("  n=%2d d=%2d: ref %4u new %4u cyc/div\n", n_bits, d_bits,
+         (unsigned)(ref_cycles / BENCH_N), (unsigned)(new_cycles / BENCH_N));
+
+  return errors;
+}
+
+//
+// Time a printf-style decimal digit loop (/ 10 then % 10 per digit)
+//
+static void bench_digits(void) {
+  static const uint32_t values[] = {7,      42,        1234,     65535,
+                                    999999, 123456789, 4000000000u};
+  volatile uint32_t     ten      = 10;
+  uint32_t              ref_sum  = 0;
+  uint32_t              new_sum  = 0;
+  uint32_t              r;
+
+  uint32_t start = rdcycle();
+  for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    uint32_t v = values[i];
+    while (v) {
+      uint32_t q = ref_udivmod(v, ten, &r);
+      ref_udivmod(v, ten, &r);
+      ref_sum += r;
+      v = q;
+    }
+  }
+  uint32_t ref_cycles = rdcycle() - start;
+
+  start = rdcycle();
+  for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    uint32_t v = values[i];
+    while (v) {
+      uint32_t q = v / ten;
+      new_sum += v % ten;
+      v = q;
+    }
+  }
+  uint32_t new_cycles = rdcycle() - start;
+
+  printf("  digit loop: ref %u new %u cycles (%s)\n", (unsigned)ref_cycles,
+         (unsigned)new_cycles, ref_sum == new_sum ? "PASS" : "FAIL");
+}
+
 void test_divmod(void) {
   printf("\n-- DivMod Test --\n");
 
@@ -36,5 +164,42 @@ void test_divmod(void) {
   printf("Signed: 100/-5=%d (%s)\n", sdiv4, sdiv4 == -20 ? "PASS" : "FAIL");
   printf("Signed: -100/-5=%d (%s)\n", sdiv5, sdiv5 == 20 ? "PASS" : "FAIL");
 
+  // Runtime operands (volatile so the compiler can't fold them)
+  volatile int32_t  smin  = INT32_MIN;
+  volatile int32_t  sneg  = -7;
+  volatile uint32_t umax  = 0xFFFFFFFFu;
+  volatile uint32_t upow2 = 64;
+
+  printf("Signed: INT32_MIN/-7=%d (%s)\n", (int)(smin / sneg),
+         smin / sneg == 306783378 ? "PASS" : "FAIL");
+  printf("Signed: INT32_MIN%%-7=%d (%s)\n", (int)(smin % sneg),
+         smin % sneg == -2 ? "PASS" : "FAIL");
+  printf("Unsigned: 0xFFFFFFFF/64=%u (%s)\n", (unsigned)(umax / upow2),
+         umax / upow2 == 0x03FFFFFFu ? "PASS" : "FAIL");
+
+  uint32_t rem;
+  uint32_t quot = __udivmodsi4(1000003, 1000, &rem);
+  printf("Udivmod: 1000003/1000=%u rem %u (%s)\n", (unsigned)quot,
+         (unsigned)rem, quot == 1000 && rem == 3 ? "PASS" : "FAIL");
+
+  //
+  // Width sweep benchmark
+  //
+  static const int n_widths[] = {8, 16, 24, 32};
+  static const int d_widths[] = {4, 8, 16, 24};
+  uint32_t         seed       = 0x12345678;
+  int              errors     = 0;
+
+  printf("Divide benchmark (avg of %d):\n", BENCH_N);
+  for (unsigned i = 0; i < sizeof(n_widths) / sizeof(n_widths[0]); i++) {
+    for (unsigned j = 0; j < sizeof(d_widths) / sizeof(d_widths[0]); j++) {
+      errors += bench_widths(&seed, n_widths[i], d_widths[j]);
+    }
+  }
+  printf("Sweep results: %d errors (%s)\n", errors,
+         errors == 0 ? "PASS" : "FAIL");
+
+  bench_digits();
+
   printf("DivMod tests complete\n");
 }
@@ -1,7 +1,11 @@
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "libsvc/csr.h"
+#include "libsvc/heap.h"
 #include "lib_test.h"
 
 //
@@ -13,12 +17,160 @@
 // - Values can be stored and retrieved correctly
 // - No memory corruption between allocations
 //
+// Then checks the libsvc size-class heap and compares it against picolibc
+// malloc: cycles per malloc and free, and heap growth for a workload that
+// frees every other block and refills the holes with different sizes.
+//
+
+#define BENCH_N 32
+#define FRAG_N 48
+
+//
+// Request sizes typical of our programs (list nodes, small buffers)
+//
+static const uint16_t bench_sizes[8] = {8, 12, 16, 24, 40, 64, 100, 200};
 
 typedef struct {
   int value;
   char name[16];
 } TestStruct;
 
+//
+// Check the size-class heap directly
+//
+static void test_svc_heap(void) {
+  int errors = 0;
+
+  for (int i = 0; i < 8; i++) {
+    uint8_t *p = svc_malloc(bench_sizes[i]);
+
+    if (p == NULL || ((uintptr_t)p & 7) != 0 ||
+        svc_malloc_usable_size(p) < bench_sizes[i]) {
+      errors++;
+      continue;
+    }
+
+    memset(p, 0xA5, bench_sizes[i]);
+    svc_free(p);
+
+    // Same class comes straight back off the free list
+    uint8_t *q = svc_malloc(bench_sizes[i]);
+    if (q != p) {
+      errors++;
+    }
+    svc_free(q);
+  }
+
+  uint32_t *z = svc_calloc(16, sizeof(uint32_t));
+  for (int i = 0; z != NULL && i < 16; i++) {
+    errors += (z[i] != 0);
+  }
+
+  char *r = svc_realloc(NULL, 10);
+  if (r == NULL) {
+    errors++;
+  } else {
+    strcpy(r, "realloc");
+    r = svc_realloc(r, 300);
+    errors += (r == NULL || strcmp(r, "realloc") != 0);
+  }
+
+  svc_free(z);
+  svc_free(r);
+
+  svc_heap_stats_t st;
+  svc_heap_stats(&st);
+  errors += (st.in_use_bytes + st.free_bytes != st.carved_bytes);
+  errors += (st.in_use_bytes != 0);
+
+  printf("Svc heap: %d errors, %u allocs, %u bytes carved (%s)\n", errors,
+         (unsigned)st.allocs, (unsigned)st.carved_bytes,
+         errors == 0 ? "PASS" : "FAIL");
+}
+
+//
+// Average cycles for BENCH_N allocations and frees of mixed sizes
+//
+// Runs the pattern once untimed so the allocator isn't timed growing the
+// heap.
+//
+static void bench_alloc(const char *label, void *(*alloc_fn)(size_t),
+                        void (*free_fn)(void *)) {
+  void    *p[BENCH_N];
+  uint32_t alloc_cycles = 0;
+  uint32_t free_cycles  = 0;
+
+  for (int pass = 0; pass < 2; pass++) {
+    uint32_t start = rdcycle();
+    for (int i = 0; i < BENCH_N; i++) {
+      p[i] = alloc_fn(bench_sizes[i & 7]);
+    }
+    alloc_cycles = rdcycle() - start;
+
+    start = rdcycle();
+    for (int i = 0; i < BENCH_N; i++) {
+      free_fn(p[i]);
+    }
+    free_cycles = rdcycle() - start;
+  }
+
+  printf("  %-10s: %4u cyc/alloc %4u cyc/free\n", label,
+         (unsigned)(alloc_cycles / BENCH_N), (unsigned)(free_cycles / BENCH_N));
+}
+
+//
+// Fragmenting workload: returns bytes the heap grew by
+//
+// Allocates FRAG_N blocks, frees every other one, then refills with sizes
+// shifted by one so the holes don't match exactly.
+//
+static uint32_t frag_run(void *(*alloc_fn)(size_t), void (*free_fn)(void *),
+                         uint32_t *requested) {
+  void *p[FRAG_N];
+  char *base = sbrk(0);
+
+  *requested = 0;
+
+  for (int i = 0; i < FRAG_N; i++) {
+    p[i] = alloc_fn(bench_sizes[i & 7]);
+    *requested += bench_sizes[i & 7];
+  }
+
+  for (int i = 0; i < FRAG_N; i += 2) {
+    free_fn(p[i]);
+    *requested -= bench_sizes[i & 7];
+  }
+
+  for (int i = 0; i < FRAG_N; i += 2) {
+    p[i] = alloc_fn(bench_sizes[(i + 1) & 7]);
+    *requested += bench_sizes[(i + 1) & 7];
+  }
+
+  uint32_t grown = (uint32_t)((char *)sbrk(0) - base);
+
+  for (int i = 0; i < FRAG_N; i++) {
+    free_fn(p[i]);
+  }
+
+  return grown;
+}
+
+static void bench_frag(void) {
+  uint32_t req;
+  uint32_t grown = frag_run(malloc, free, &req);
+
+  printf("Fragmentation (%u bytes live):\n", (unsigned)req);
+  printf("  malloc    : heap grew %5u bytes\n", (unsigned)grown);
+
+  grown = frag_run(svc_malloc, svc_free, &req);
+  printf("  svc_malloc: heap grew %5u bytes\n", (unsigned)grown);
+
+  // Running it again must not grow the heap: every class has free blocks
+  grown = frag_run(svc_malloc, svc_free, &req);
+  printf("  svc rerun : heap grew %5u bytes (%s)\n", (unsigned)grown,
+         grown == 0 ? "PASS" : "FAIL");
+}
+
 void test_malloc(void) {
   printf("\n-- Malloc Test --\n");
 
@@ -59,6 +211,14 @@ void test_malloc(void) {
     printf("Malloc test: FAIL\n");
   }
 
+  test_svc_heap();
+
+  printf("Allocation benchmark (avg of %d, 8-200 bytes):\n", BENCH_N);
+  bench_alloc("malloc", malloc, free);
+  bench_alloc("svc_malloc", svc_malloc, svc_free);
+
+  bench_frag();
+
   // Test alignment (addresses should be 4-byte aligned)
   printf("Malloc tests complete\n");
 }
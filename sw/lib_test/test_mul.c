@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "libsvc/csr.h"
+#include "libsvc/divmod.h"
+#include "libsvc/mul.h"
+#include "lib_test.h"
+
+//
+// Test soft multiply and 64-bit division
+//
+// Verifies __mulsi3, __muldi3 and __udivmoddi4 (and the signed 64-bit
+// wrappers) against bit-serial references and known values. The routines
+// are called directly, so this exercises the soft runtime on every
+// architecture, including ones where * compiles to mul.
+//
+// Then benchmarks __mulsi3 against a fixed 32-iteration shift-add across
+// multiplier widths, and times typical 64-bit divides.
+//
+
+#define BENCH_N 16
+
+//
+// Reference: bit-serial shift-add multiply (always 32 iterations)
+//
+static uint32_t __attribute__((noinline)) ref_mulsi3(uint32_t a, uint32_t b) {
+  uint32_t result = 0;
+
+  for (int i = 0; i < 32; i++) {
+    if (b & 1) {
+      result += a;
+    }
+    a <<= 1;
+    b >>= 1;
+  }
+
+  return result;
+}
+
+//
+// Reference: 64-bit bit-serial long division (always 64 iterations)
+//
+static uint64_t __attribute__((noinline))
+ref_udivmoddi4(uint64_t dividend, uint64_t divisor, uint64_t *rem) {
+  uint64_t quotient  = 0;
+  uint64_t remainder = 0;
+
+  for (int i = 63; i >= 0; i--) {
+    remainder = (remainder << 1) | ((dividend >> i) & 1);
+    if (remainder >= divisor) {
+      remainder -= divisor;
+      quotient |= (uint64_t)1 << i;
+    }
+  }
+
+  *rem = remainder;
+  return quotient;
+}
+
+//
+// Random operand with at most the given number of significant bits
+//
+static uint32_t width_operand(uint32_t *seed, int bits) {
+  uint32_t x = xorshift32(seed);
+  return (bits < 32) ? x & ((1u << bits) - 1) : x;
+}
+
+//
+// Check multiply and 64-bit divide on pseudo-random operands
+//
+// Returns the number of mismatches.
+//
+static int check_random(uint32_t *seed) {
+  int errors = 0;
+
+  for (int i = 0; i < 64; i++) {
+    uint32_t a  = width_operand(seed, 1 + (i & 31));
+    uint32_t b  = width_operand(seed, 32 - (i & 31));
+    uint64_t a2 = ((uint64_t)xorshift32(seed) << 32) | xorshift32(seed);
+    uint64_t b2 = (i & 1) ? a >> (i & 15) : ((uint64_t)b << 16) | a;
+
+    if (__mulsi3(a, b) != ref_mulsi3(a, b)) {
+      errors++;
+    }
+
+    // Low word of the full product must match, and __muldi3 must agree
+    uint64_t p = svc_umul32x64(a, b);
+    if ((uint32_t)p != ref_mulsi3(a, b) || __muldi3(a, b) != p) {
+      errors++;
+    }
+
+    if (b2 != 0) {
+      uint64_t exp_r;
+      uint64_t exp_q = ref_udivmoddi4(a2, b2, &exp_r);
+      uint64_t r;
+      uint64_t q = __udivmoddi4(a2, b2, &r);
+
+      if (q != exp_q || r != exp_r) {
+        printf("  FAIL: 0x%08x%08x / 0x%08x%08x\n", (unsigned)(a2 >> 32),
+               (unsigned)a2, (unsigned)(b2 >> 32), (unsigned)b2);
+        errors++;
+      }
+    }
+  }
+
+  return errors;
+}
+
+//
+// Time BENCH_N multiplies of each routine for one multiplier width
+//
+static void bench_mul(uint32_t *seed, int b_bits) {
+  uint32_t a[BENCH_N];
+  uint32_t b[BENCH_N];
+  uint32_t ref_p[BENCH_N];
+  uint32_t new_p[BENCH_N];
+
+  for (int i = 0; i < BENCH_N; i++) {
+    a[i] = xorshift32(seed);
+    b[i] = width_operand(seed, b_bits);
+  }
+
+  uint32_t start = rdcycle();
+  for (int i = 0; i < BENCH_N; i++) {
+    ref_p[i] = ref_mulsi3(a[i], b[i]);
+  }
+  uint32_t ref_cycles = rdcycle() - start;
+
+  start = rdcycle();
+  for (int i = 0; i < BENCH_N; i++) {
+    new_p[i] = __mulsi3(a[i], b[i]);
+  }
+  uint32_t new_cycles = rdcycle() - start;
+
+  int match = 1;
+  for (int i = 0; i < BENCH_N; i++) {
+    match &= (ref_p[i] == new_p[i]);
+  }
+
+  printf("  b=%2d bits: ref %4u new %4u cyc/mul %s\n", b_bits,
+         (unsigned)(ref_cycles / BENCH_N), (unsigned)(new_cycles / BENCH_N),
+         match ? "PASS" : "FAIL");
+}
+
+//
+// Time one 64-bit divide against the bit-serial reference
+//
+static void bench_div64(const char *label, uint64_t n, uint64_t d) {
+  uint64_t ref_r;
+  uint64_t new_r;
+
+  uint32_t start      = rdcycle();
+  uint64_t ref_q      = ref_udivmoddi4(n, d, &ref_r);
+  uint32_t ref_cycles = rdcycle() - start;
+
+  start               = rdcycle();
+  uint64_t new_q      = __udivmoddi4(n, d, &new_r);
+  uint32_t new_cycles = rdcycle() - start;
+
+  printf("  %-12s: ref %5u new %4u cycles %s\n", label, (unsigned)ref_cycles,
+         (unsigned)new_cycles,
+         ref_q == new_q && ref_r == new_r ? "PASS" : "FAIL");
+}
+
+void test_mul(void) {
+  printf("\n-- Mul Test --\n");
+
+  // Known values
+  printf("Mulsi3: 12345*6789=%u (%s)\n", (unsigned)__mulsi3(12345, 6789),
+         __mulsi3(12345, 6789) == 83810205u ? "PASS" : "FAIL");
+  printf("Mulsi3: 0xFFFFFFFF*0xFFFFFFFF=0x%08x (%s)\n",
+         (unsigned)__mulsi3(0xFFFFFFFF, 0xFFFFFFFF),
+         __mulsi3(0xFFFFFFFF, 0xFFFFFFFF) == 1 ? "PASS" : "FAIL");
+
+  uint64_t p = svc_umul32x64(0xFFFFFFFF, 0xFFFFFFFF);
+  printf("Umul32x64: 0xFFFFFFFF^2=0x%08x%08x (%s)\n", (unsigned)(p >> 32),
+         (unsigned)p, p == 0xFFFFFFFE00000001ull ? "PASS" : "FAIL");
+
+  // Runtime operands (volatile so the compiler can't fold them)
+  volatile int64_t  sneg = -1000000000000ll;
+  volatile int64_t  sdiv = 7;
+  volatile uint64_t ubig = 0xFFFFFFFFFFFFFFFFull;
+  volatile uint64_t udiv = 25000000;
+
+  printf("Divdi3: -10^12/7 (%s)\n",
+         sneg / sdiv == -142857142857ll ? "PASS" : "FAIL");
+  printf("Moddi3: -10^12%%7 (%s)\n", sneg % sdiv == -1 ? "PASS" : "FAIL");
+  printf("Udivdi3: (2^64-1)/25000000 (%s)\n",
+         ubig / udiv == 737869762948ull && ubig % udiv == 9551615
+             ? "PASS"
+             : "FAIL");
+
+  uint64_t zero_r;
+  uint64_t zero_q = __udivmoddi4(1234, 0, &zero_r);
+  printf("Divide by zero: %u rem %u (%s)\n", (unsigned)zero_q,
+         (unsigned)zero_r, zero_q == 0 && zero_r == 0 ? "PASS" : "FAIL");
+
+  uint32_t seed   = 0xBADC0DE5;
+  int      errors = check_random(&seed);
+  printf("Random: %d errors (%s)\n", errors, errors == 0 ? "PASS" : "FAIL");
+
+  printf("Multiply benchmark (avg of %d, 32-bit a):\n", BENCH_N);
+  bench_mul(&seed, 4);
+  bench_mul(&seed, 8);
+  bench_mul(&seed, 16);
+  bench_mul(&seed, 32);
+
+  printf("64-bit divide benchmark:\n");
+  bench_div64("cycles/freq", 0x0000001234567890ull, 25000000);
+  bench_div64("64/32 full", 0xFEDCBA9876543210ull, 0x9ABCDEF1);
+  bench_div64("64/64", 0xFEDCBA9876543210ull, 0x123456789ull);
+
+  // gettimeofday divides the 64-bit cycle count by the clock frequency
+  struct timeval tv;
+  uint32_t       start = rdcycle();
+  int            ret   = gettimeofday(&tv, NULL);
+  uint32_t       cyc   = rdcycle() - start;
+  printf("gettimeofday: %u.%06u s in %u cycles (%s)\n", (unsigned)tv.tv_sec,
+         (unsigned)tv.tv_usec, (unsigned)cyc,
+         ret == 0 && tv.tv_usec < 1000000 ? "PASS" : "FAIL");
+
+  printf("Mul tests complete\n");
+}
@@ -1,8 +1,89 @@
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "libsvc/csr.h"
+#include "libsvc/fmt.h"
 #include "lib_test.h"
 
+#define BENCH_N 8
+
+//
+// Compare svc_snprintf against picolibc snprintf for one value
+//
+// Returns 1 on mismatch.
+//
+static int check_fmt(const char *fmt, int32_t value) {
+  char exp[32];
+  char got[32];
+
+  int exp_len = snprintf(exp, sizeof(exp), fmt, value);
+  int got_len = svc_snprintf(got, sizeof(got), fmt, value);
+
+  if (exp_len != got_len || strcmp(exp, got) != 0) {
+    printf("  FAIL: \"%s\" -> [%s] (expected [%s])\n", fmt, got, exp);
+    return 1;
+  }
+
+  return 0;
+}
+
+//
+// Check svc_snprintf output and truncation against snprintf
+//
+static void test_svc_fmt(void) {
+  static const char *fmts[] = {"%d",  "%u",    "%x",   "%X",   "%05d",
+                                "%5u", "%-5d|", "%08x", "%10u", "%lu"};
+  static const int32_t values[] = {
+      0,   1,         -1,         9,         10,
+      -42, 123456789, 0x7FFFFFFF, INT32_MIN, (int32_t)0xDEADBEEF,
+  };
+  int errors = 0;
+
+  for (unsigned f = 0; f < sizeof(fmts) / sizeof(fmts[0]); f++) {
+    for (unsigned v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+      errors += check_fmt(fmts[f], values[v]);
+    }
+  }
+
+  char buf[8];
+  int  len = svc_snprintf(buf, sizeof(buf), "%s=%u", "count", 12345u);
+  errors += (len != 11 || strcmp(buf, "count=1") != 0);
+
+  printf("svc_snprintf vs snprintf: %d errors (%s)\n", errors,
+         errors == 0 ? "PASS" : "FAIL");
+}
+
+//
+// Time one decimal conversion through each path
+//
+static void bench_fmt(uint32_t value) {
+  char     buf[SVC_UTOA_BUF_SIZE + 1];
+  uint32_t start;
+
+  start = (uint32_t)read_cycles();
+  for (int i = 0; i < BENCH_N; i++) {
+    snprintf(buf, sizeof(buf), "%u", (unsigned)value);
+  }
+  uint32_t libc_cycles = (uint32_t)read_cycles() - start;
+
+  start = (uint32_t)read_cycles();
+  for (int i = 0; i < BENCH_N; i++) {
+    svc_snprintf(buf, sizeof(buf), "%u", (unsigned)value);
+  }
+  uint32_t svc_cycles = (uint32_t)read_cycles() - start;
+
+  start = (uint32_t)read_cycles();
+  for (int i = 0; i < BENCH_N; i++) {
+    svc_utoa(value, buf);
+  }
+  uint32_t utoa_cycles = (uint32_t)read_cycles() - start;
+
+  printf("  %10u: snprintf %5u svc_snprintf %4u svc_utoa %4u cyc/call\n",
+         (unsigned)value, (unsigned)(libc_cycles / BENCH_N),
+         (unsigned)(svc_cycles / BENCH_N), (unsigned)(utoa_cycles / BENCH_N));
+}
+
 //
 // Test printf format specifiers with width and zero-padding
 //
@@ -35,5 +116,12 @@ void test_printf(void) {
   printf("Zero: %03u\n", 0);
   printf("Large: %010u\n", 123456789);
 
+  test_svc_fmt();
+
+  printf("Format benchmark (avg of %d, \"%%u\"):\n", BENCH_N);
+  bench_fmt(7);
+  bench_fmt(12345);
+  bench_fmt(4294967295u);
+
   printf("Printf tests complete\n");
 }
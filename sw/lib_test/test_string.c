@@ -1,16 +1,210 @@
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "libsvc/csr.h"
+#include "libsvc/str.h"
 #include "lib_test.h"
 
+#define BENCH_MAX 1024
+
+static uint8_t buf_a[BENCH_MAX + 8] __attribute__((aligned(4)));
+static uint8_t buf_b[BENCH_MAX + 8] __attribute__((aligned(4)));
+static uint8_t buf_r[BENCH_MAX + 8] __attribute__((aligned(4)));
+
+static const uint16_t bench_sizes[] = {16, 64, 256, 1024};
+
+//
+// Check lengths: short copies, around one word, and through the 8-word loop
 //
-// Test string function functionality
+static const uint8_t check_sizes[] = {0,  1,  2,  3,  4,  5,  6,  7,  8, 9,
+                                      11, 15, 16, 17, 31, 32, 33, 40, 47};
+
 //
-// Verifies that:
-// - strcpy correctly copies strings
-// - strcmp returns correct comparison results (negative/zero/positive)
-// - strlen returns correct string lengths
+// Bytes compared after each check (covers the largest size plus offsets)
 //
+#define CHECK_SPAN 56
+
+static int sign(int x) {
+  return (x > 0) - (x < 0);
+}
+
+static void fill_pattern(uint8_t* p, size_t n, uint8_t seed) {
+  for (size_t i = 0; i < n; i++) {
+    p[i] = (uint8_t)(seed + i * 7 + 1);
+  }
+}
+
+//
+// Check the libsvc versions against picolibc across sizes and every
+// pairing of source/destination misalignment
+//
+static int check_svc_string(void) {
+  int errors = 0;
+
+  for (size_t i = 0; i < sizeof(check_sizes); i++) {
+    size_t n = check_sizes[i];
+
+    for (size_t da = 0; da < 4; da++) {
+      for (size_t sa = 0; sa < 4; sa++) {
+        fill_pattern(buf_a, CHECK_SPAN, (uint8_t)n);
+        fill_pattern(buf_b, CHECK_SPAN, 0x55);
+        fill_pattern(buf_r, CHECK_SPAN, 0x55);
+
+        memcpy(buf_r + da, buf_a + sa, n);
+        svc_memcpy(buf_b + da, buf_a + sa, n);
+        errors += memcmp(buf_r, buf_b, CHECK_SPAN) != 0;
+
+        memmove(buf_r + da + 2, buf_r + sa, n);
+        svc_memmove(buf_b + da + 2, buf_b + sa, n);
+        errors += memcmp(buf_r, buf_b, CHECK_SPAN) != 0;
+
+        memmove(buf_r + sa, buf_r + da + 2, n);
+        svc_memmove(buf_b + sa, buf_b + da + 2, n);
+        errors += memcmp(buf_r, buf_b, CHECK_SPAN) != 0;
+
+        memset(buf_r + da, (int)n, n);
+        svc_memset(buf_b + da, (int)n, n);
+        errors += memcmp(buf_r, buf_b, CHECK_SPAN) != 0;
+
+        // Differ in the last byte only
+        memcpy(buf_b, buf_a, CHECK_SPAN);
+        if (n > 0) {
+          buf_b[da + n - 1] ^= 0x80;
+        }
+        errors += sign(memcmp(buf_a + sa, buf_b + da, n)) !=
+                  sign(svc_memcmp(buf_a + sa, buf_b + da, n));
+        errors += sign(memcmp(buf_a + da, buf_b + da, n)) !=
+                  sign(svc_memcmp(buf_a + da, buf_b + da, n));
+
+        // Strings of length n, equal and then differing at the end
+        char* x = (char*)buf_a + sa;
+        char* y = (char*)buf_b + da;
+        for (size_t k = 0; k < n; k++) {
+          x[k] = (char)('a' + k % 26);
+        }
+        x[n] = '\0';
+        memcpy(y, x, n + 1);
+        errors += svc_strlen(x) != n;
+        errors += svc_strcmp(x, y) != 0;
+        if (n > 0) {
+          y[n - 1] = (char)0xF0;
+          errors += sign(strcmp(x, y)) != sign(svc_strcmp(x, y));
+          errors += sign(strcmp(y, x)) != sign(svc_strcmp(y, x));
+        }
+      }
+    }
+  }
+
+  return errors;
+}
+
+//
+// Benchmarked operations: src is the (possibly misaligned) input, other is
+// an aligned scratch or reference buffer of the same contents
+//
+typedef void (*bench_fn_t)(uint8_t* src, uint8_t* other, size_t n);
+
+static void libc_memcpy(uint8_t* src, uint8_t* other, size_t n) {
+  memcpy(other, src, n);
+}
+static void svc_memcpy_op(uint8_t* src, uint8_t* other, size_t n) {
+  svc_memcpy(other, src, n);
+}
+static void libc_memset(uint8_t* src, uint8_t* other, size_t n) {
+  (void)other;
+  memset(src, 0x5A, n);
+}
+static void svc_memset_op(uint8_t* src, uint8_t* other, size_t n) {
+  (void)other;
+  svc_memset(src, 0x5A, n);
+}
+static void libc_memcmp(uint8_t* src, uint8_t* other, size_t n) {
+  (void)memcmp(src, other, n);
+}
+static void svc_memcmp_op(uint8_t* src, uint8_t* other, size_t n) {
+  (void)svc_memcmp(src, other, n);
+}
+static void libc_strlen(uint8_t* src, uint8_t* other, size_t n) {
+  (void)other;
+  (void)n;
+  (void)strlen((char*)src);
+}
+static void svc_strlen_op(uint8_t* src, uint8_t* other, size_t n) {
+  (void)other;
+  (void)n;
+  (void)svc_strlen((char*)src);
+}
+static void libc_strcmp(uint8_t* src, uint8_t* other, size_t n) {
+  (void)n;
+  (void)strcmp((char*)src, (char*)other);
+}
+static void svc_strcmp_op(uint8_t* src, uint8_t* other, size_t n) {
+  (void)n;
+  (void)svc_strcmp((char*)src, (char*)other);
+}
+
+typedef struct {
+  const char* label;
+  bench_fn_t  libc_fn;
+  bench_fn_t  svc_fn;
+} BenchOp;
+
+static const BenchOp bench_ops[] = {
+    {"memcpy", libc_memcpy, svc_memcpy_op},
+    {"memset", libc_memset, svc_memset_op},
+    {"memcmp", libc_memcmp, svc_memcmp_op},
+    {"strlen", libc_strlen, svc_strlen_op},
+    {"strcmp", libc_strcmp, svc_strcmp_op},
+};
+
+static uint32_t time_op(bench_fn_t fn, uint8_t* src, uint8_t* other,
+                        size_t n) {
+  uint64_t start = read_cycles();
+  fn(src, other, n);
+  return (uint32_t)(read_cycles() - start);
+}
+
+//
+// Bytes per cycle, in hundredths
+//
+static unsigned bpc(size_t bytes, uint32_t cycles) {
+  return cycles == 0 ? 0 : (unsigned)(bytes * 100 / cycles);
+}
+
+//
+// Bytes per cycle of picolibc vs libsvc across sizes, with the input
+// aligned and off by one byte
+//
+static void bench_svc_string(void) {
+  printf("String benchmark (bytes/cycle, picolibc -> svc):\n");
+
+  for (size_t i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+    size_t n = bench_sizes[i];
+
+    for (size_t j = 0; j < sizeof(bench_ops) / sizeof(bench_ops[0]); j++) {
+      const BenchOp* op = &bench_ops[j];
+      unsigned       r[4];
+
+      for (size_t off = 0; off < 2; off++) {
+        uint8_t* src = buf_a + off;
+
+        // A string of n - 1 characters, with an equal copy in buf_r
+        memset(src, 'a', n - 1);
+        src[n - 1] = '\0';
+        memcpy(buf_r, src, n);
+
+        r[off * 2]     = bpc(n, time_op(op->libc_fn, src, buf_r, n));
+        r[off * 2 + 1] = bpc(n, time_op(op->svc_fn, src, buf_r, n));
+      }
+
+      printf("  %-7s %4u: aligned %u.%02u -> %u.%02u, +1 %u.%02u -> %u.%02u\n",
+             op->label, (unsigned)n, r[0] / 100, r[0] % 100, r[1] / 100,
+             r[1] % 100, r[2] / 100, r[2] % 100, r[3] / 100, r[3] % 100);
+    }
+  }
+}
+
 void test_string(void) {
   printf("\n-- String Test --\n");
 
@@ -38,4 +232,9 @@ void test_string(void) {
          len1 == 5 ? "PASS" : "FAIL");
   printf("strlen(Test): %u (%s)\n", (unsigned)len2,
          len2 == 4 ? "PASS" : "FAIL");
+
+  int errors = check_svc_string();
+  printf("Svc string: %d errors (%s)\n", errors, errors == 0 ? "PASS" : "FAIL");
+
+  bench_svc_string();
 }
@@ -0,0 +1,89 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libsvc/heap.h"
+
+//
+// malloc() replacement test
+//
+// Built with SVC_MALLOC = 1, so malloc/free/calloc/realloc, and picolibc
+// routines that allocate (strdup), must land in the libsvc size-class heap.
+// Each check compares what the standard API did against svc_heap_stats().
+//
+
+static int errors;
+
+static void check(const char *name, int ok) {
+  printf("%-28s %s\n", name, ok ? "PASS" : "FAIL");
+  errors += !ok;
+}
+
+int main(void) {
+  svc_heap_stats_t start;
+  svc_heap_stats_t before;
+  svc_heap_stats_t st;
+
+  printf("=== malloc test ===\n");
+  svc_heap_stats(&start);
+  before = start;
+
+  // malloc goes through the size-class heap
+  char *p = malloc(40);
+  svc_heap_stats(&st);
+  check("malloc uses svc heap", p != NULL && st.allocs == before.allocs + 1);
+  check("malloc 8-byte aligned", ((uintptr_t)p & 7) == 0);
+  check("malloc usable size",
+        p != NULL && svc_malloc_usable_size(p) >= 40);
+
+  // Freed block comes straight back for the same class
+  free(p);
+  char *q = malloc(40);
+  check("free then malloc reuses", q == p);
+  free(q);
+
+  // calloc zeroes even a recycled block
+  void *dirty = malloc(64);
+  if (dirty != NULL) {
+    memset(dirty, 0xA5, 64);
+  }
+  free(dirty);
+  uint32_t *z  = calloc(16, sizeof(uint32_t));
+  int       nz = 0;
+  for (int i = 0; z != NULL && i < 16; i++) {
+    nz += (z[i] != 0);
+  }
+  check("calloc zeroed", z != NULL && nz == 0);
+
+  // realloc(NULL) is malloc, growing keeps the contents
+  char *r = realloc(NULL, 10);
+  check("realloc NULL", r != NULL);
+  if (r != NULL) {
+    strcpy(r, "realloc");
+    r = realloc(r, 300);
+    check("realloc grow keeps data", r != NULL && strcmp(r, "realloc") == 0);
+  }
+
+  // picolibc's own allocations come from the same heap
+  svc_heap_stats(&before);
+  char *s = strdup("picolibc strdup");
+  svc_heap_stats(&st);
+  check("strdup uses svc heap",
+        s != NULL && st.allocs == before.allocs + 1 &&
+            strcmp(s, "picolibc strdup") == 0);
+
+  free(s);
+  free(r);
+  free(z);
+  free(NULL);
+
+  svc_heap_stats(&st);
+  check("free returns blocks",
+        st.in_use_bytes == start.in_use_bytes &&
+            st.in_use_bytes + st.free_bytes == st.carved_bytes);
+
+  printf("malloc test: %d errors (%s)\n", errors, errors ? "FAIL" : "PASS");
+
+  return errors;
+}
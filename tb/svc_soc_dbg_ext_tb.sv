@@ -0,0 +1,749 @@
+`include "svc_unit.sv"
+`include "svc_soc_dbg_ext.sv"
+
+module svc_soc_dbg_ext_tb;
+  `TEST_CLK_NS(clk, 10);
+  `TEST_RST_N(clk, rst_n);
+
+  localparam int MEM_WORDS = 256;
+
+  logic        urx_valid;
+  logic [ 7:0] urx_data;
+  logic        urx_ready;
+  logic        utx_valid;
+  logic [ 7:0] utx_data;
+  logic        utx_ready;
+  logic        brx_valid;
+  logic [ 7:0] brx_data;
+  logic        brx_ready;
+  logic        btx_valid;
+  logic [ 7:0] btx_data;
+  logic        btx_ready;
+  logic        rd_en;
+  logic        rd_imem;
+  logic [31:0] rd_idx;
+  logic [31:0] rd_data;
+
+  // The bridge memory is split in two: IMEM then DMEM
+  svc_soc_dbg_ext #(
+      .RX_FIFO_DEPTH(64),
+      .IMEM_DEPTH   (MEM_WORDS / 2),
+      .DMEM_DEPTH   (MEM_WORDS / 2)
+  ) uut (
+      .clk      (clk),
+      .rst_n    (rst_n),
+      .urx_valid(urx_valid),
+      .urx_data (urx_data),
+      .urx_ready(urx_ready),
+      .utx_valid(utx_valid),
+      .utx_data (utx_data),
+      .utx_ready(utx_ready),
+      .brx_valid(brx_valid),
+      .brx_data (brx_data),
+      .brx_ready(brx_ready),
+      .btx_valid(btx_valid),
+      .btx_data (btx_data),
+      .btx_ready(btx_ready),
+      .rd_en    (rd_en),
+      .rd_imem  (rd_imem),
+      .rd_idx   (rd_idx),
+      .rd_data  (rd_data)
+  );
+
+  //
+  // Bridge model: the svc_rv_dbg_bridge commands (0x00-0x03) on a small
+  // memory, with an error status for writes past its end. brx_ready drops
+  // now and then to exercise the flow control.
+  //
+  logic [31:0] mem       [MEM_WORDS];
+  logic [ 7:0] ctrl;
+  logic [ 7:0] bcmd      [      $];
+  logic [ 7:0] brsp      [      $];
+  int          bursts;
+  int          rx_count;
+
+  function automatic void bridge_write(input int addr, input logic [31:0] data,
+                                       inout logic [7:0] st);
+    if (addr < 0 || addr >= MEM_WORDS * 4) begin
+      st = 8'h01;
+    end else begin
+      mem[addr/4] = data;
+    end
+  endfunction
+
+  function automatic void bridge_cmd();
+    int          need;
+    int          addr;
+    int          len;
+    logic [ 7:0] st;
+    logic [31:0] data;
+
+    if (bcmd[0] != 8'hDB) begin
+      bcmd.delete();
+      return;
+    end
+
+    if (bcmd.size() < 2) begin
+      return;
+    end
+
+    case (bcmd[1])
+      8'h00:   need = 2;
+      8'h01:   need = 3;
+      8'h02:   need = 10;
+      8'h03:   need = bcmd.size() < 8 ? 8 : 8 + 4 * int'({bcmd[7], bcmd[6]});
+      default: need = 2;
+    endcase
+
+    if (bcmd.size() < need) begin
+      return;
+    end
+
+    st   = 8'h00;
+    addr = int'({bcmd[5], bcmd[4], bcmd[3], bcmd[2]});
+
+    case (bcmd[1])
+      8'h00: begin
+        brsp.push_back(8'hBD);
+        brsp.push_back(st);
+        brsp.push_back(ctrl);
+        bcmd.delete();
+        return;
+      end
+
+      8'h01: ctrl = bcmd[2];
+
+      8'h02: begin
+        data = {bcmd[9], bcmd[8], bcmd[7], bcmd[6]};
+        bridge_write(addr, data, st);
+      end
+
+      8'h03: begin
+        len = int'({bcmd[7], bcmd[6]});
+        for (int i = 0; i < len; i++) begin
+          data = {bcmd[11+4*i], bcmd[10+4*i], bcmd[9+4*i], bcmd[8+4*i]};
+          bridge_write(addr + 4 * i, data, st);
+        end
+        bursts++;
+      end
+
+      default: st = 8'h01;
+    endcase
+
+    brsp.push_back(8'hBD);
+    brsp.push_back(st);
+    bcmd.delete();
+  endfunction
+
+  always @(posedge clk) begin
+    if (!rst_n) begin
+      ctrl      = 8'h03;
+      bursts    = 0;
+      rx_count  = 0;
+      bcmd.delete();
+      brsp.delete();
+      brx_ready <= 1'b1;
+      btx_valid <= 1'b0;
+      btx_data  <= 8'h00;
+    end else begin
+      if (brx_valid && brx_ready) begin
+        bcmd.push_back(brx_data);
+        rx_count++;
+        bridge_cmd();
+      end
+
+      if (btx_valid && btx_ready) begin
+        void'(brsp.pop_front());
+      end
+
+      brx_ready <= ($urandom_range(0, 3) != 0);
+      btx_valid <= brsp.size() != 0;
+      btx_data  <= brsp.size() != 0 ? brsp[0] : 8'h00;
+    end
+  end
+
+  //
+  // Read port on the same memory
+  //
+  always @(posedge clk) begin
+    if (rd_en) begin
+      rd_data <= mem[rd_imem ? rd_idx : MEM_WORDS/2+rd_idx];
+    end
+  end
+
+  //
+  // Host side
+  //
+  logic [7:0] host_rx[$];
+
+  always @(posedge clk) begin
+    if (!rst_n) begin
+      host_rx.delete();
+    end else if (utx_valid && utx_ready) begin
+      host_rx.push_back(utx_data);
+    end
+  end
+
+  always_ff @(posedge clk) begin
+    if (~rst_n) begin
+      urx_valid <= 1'b0;
+      urx_data  <= 8'h00;
+      utx_ready <= 1'b1;
+    end
+  end
+
+  task automatic send_byte(input logic [7:0] b);
+    urx_valid = 1'b1;
+    urx_data  = b;
+    `CHECK_TRUE(urx_ready);
+    `TICK(clk);
+    urx_valid = 1'b0;
+  endtask
+
+  task automatic send_u16(input logic [15:0] v);
+    send_byte(v[7:0]);
+    send_byte(v[15:8]);
+  endtask
+
+  task automatic send_u32(input logic [31:0] v);
+    send_u16(v[15:0]);
+    send_u16(v[31:16]);
+  endtask
+
+  task automatic recv_byte(output logic [7:0] b);
+    for (int i = 0; i < 10000 && host_rx.size() == 0; i++) begin
+      `TICK(clk);
+    end
+
+    `CHECK_TRUE(host_rx.size() != 0);
+    b = host_rx.size() != 0 ? host_rx.pop_front() : 8'hXX;
+  endtask
+
+  task automatic expect_byte(input logic [7:0] expected);
+    logic [7:0] b;
+    recv_byte(b);
+    `CHECK_EQ(b, expected);
+  endtask
+
+  task automatic expect_rsp(input logic [7:0] st);
+    expect_byte(8'hBD);
+    expect_byte(st);
+  endtask
+
+  task automatic expect_u32(input logic [31:0] expected);
+    logic [31:0] v;
+    for (int i = 0; i < 4; i++) begin
+      recv_byte(v[8*i+:8]);
+    end
+    `CHECK_EQ(v, expected);
+  endtask
+
+  task automatic skip_bytes(input int n);
+    logic [7:0] b;
+    for (int i = 0; i < n; i++) begin
+      recv_byte(b);
+    end
+  endtask
+
+  task automatic send_burst(input logic [31:0] addr, input int len,
+                            input logic [31:0] base);
+    send_byte(8'hDB);
+    send_byte(8'h03);
+    send_u32(addr);
+    send_u16(16'(len));
+    for (int i = 0; i < len; i++) begin
+      send_u32(base + 32'(i));
+    end
+  endtask
+
+  task automatic send_seq_burst(input logic [7:0] seq, input logic [31:0] addr,
+                                input int len, input logic [31:0] base);
+    send_byte(8'hDB);
+    send_byte(8'h04);
+    send_byte(seq);
+    send_u32(addr);
+    send_u16(16'(len));
+    for (int i = 0; i < len; i++) begin
+      send_u32(base + 32'(i));
+    end
+  endtask
+
+  task automatic send_z_burst(input logic [7:0] seq, input logic [31:0] addr,
+                              input int len, input logic [7:0] stream[$]);
+    send_byte(8'hDB);
+    send_byte(8'h05);
+    send_byte(seq);
+    send_u32(addr);
+    send_u16(16'(len));
+    send_u16(16'(stream.size()));
+    foreach (stream[i]) begin
+      send_byte(stream[i]);
+    end
+  endtask
+
+  task automatic send_crc(input logic [31:0] addr, input int block,
+                          input int count);
+    send_byte(8'hDB);
+    send_byte(8'h06);
+    send_u32(addr);
+    send_u16(16'(block));
+    send_u16(16'(count));
+  endtask
+
+  task automatic send_fill(input logic [7:0] seq, input logic [31:0] addr,
+                           input logic [31:0] count, input logic [31:0] value);
+    send_byte(8'hDB);
+    send_byte(8'h07);
+    send_byte(seq);
+    send_u32(addr);
+    send_u32(count);
+    send_u32(value);
+  endtask
+
+  task automatic send_read(input logic [31:0] addr);
+    send_byte(8'hDB);
+    send_byte(8'h08);
+    send_u32(addr);
+  endtask
+
+  task automatic send_read_burst(input logic [31:0] addr, input int len);
+    send_byte(8'hDB);
+    send_byte(8'h09);
+    send_u32(addr);
+    send_u16(16'(len));
+  endtask
+
+  //
+  // Test: capability bitmap and RX FIFO depth
+  //
+  task automatic test_caps();
+    send_byte(8'hDB);
+    send_byte(8'h0A);
+    expect_rsp(8'h00);
+    expect_byte(8'h1F);
+
+    // log2 of RX_FIFO_DEPTH
+    expect_byte(8'd6);
+  endtask
+
+  //
+  // Test: control commands pass through with the bridge's response
+  //
+  task automatic test_ctrl_passthrough();
+    send_byte(8'hDB);
+    send_byte(8'h00);
+    expect_rsp(8'h00);
+    expect_byte(8'h03);
+
+    send_byte(8'hDB);
+    send_byte(8'h01);
+    send_byte(8'h01);
+    expect_rsp(8'h00);
+
+    send_byte(8'hDB);
+    send_byte(8'h00);
+    expect_rsp(8'h00);
+    expect_byte(8'h01);
+  endtask
+
+  //
+  // Test: single word and burst writes pass through
+  //
+  task automatic test_write_passthrough();
+    int start;
+
+    start = bursts;
+    send_byte(8'hDB);
+    send_byte(8'h02);
+    send_u32(32'h10);
+    send_u32(32'hDEADBEEF);
+    expect_rsp(8'h00);
+    `CHECK_EQ(mem[4], 32'hDEADBEEF);
+
+    send_burst(32'h20, 3, 32'h100);
+    expect_rsp(8'h00);
+    `CHECK_EQ(mem[8], 32'h100);
+    `CHECK_EQ(mem[9], 32'h101);
+    `CHECK_EQ(mem[10], 32'h102);
+    `CHECK_EQ(bursts, start + 1);
+  endtask
+
+  //
+  // Test: sequenced bursts sent back to back are each written and acked
+  //
+  task automatic test_seq_bursts();
+    int start;
+
+    start = bursts;
+    send_seq_burst(8'h05, 32'h40, 4, 32'h200);
+    send_seq_burst(8'h06, 32'h80, 2, 32'h300);
+
+    expect_rsp(8'h00);
+    expect_byte(8'h05);
+    expect_rsp(8'h00);
+    expect_byte(8'h06);
+
+    `CHECK_EQ(mem[16], 32'h200);
+    `CHECK_EQ(mem[19], 32'h203);
+    `CHECK_EQ(mem[32], 32'h300);
+    `CHECK_EQ(mem[33], 32'h301);
+    `CHECK_EQ(bursts, start + 2);
+  endtask
+
+  //
+  // Test: a bridge error is acked with the failing burst's sequence number
+  //
+  task automatic test_seq_burst_error();
+    send_seq_burst(8'h07, 32'(MEM_WORDS * 4 - 4), 2, 32'h0);
+    expect_rsp(8'h01);
+    expect_byte(8'h07);
+
+    send_seq_burst(8'h08, 32'h0, 1, 32'h55);
+    expect_rsp(8'h00);
+    expect_byte(8'h08);
+    `CHECK_EQ(mem[0], 32'h55);
+  endtask
+
+  //
+  // Test: an empty sequenced burst is acked without touching the bridge
+  //
+  task automatic test_seq_burst_empty();
+    int start;
+
+    start = rx_count;
+    send_seq_burst(8'h09, 32'h0, 0, 32'h0);
+    expect_rsp(8'h00);
+    expect_byte(8'h09);
+    `CHECK_EQ(rx_count, start);
+  endtask
+
+  //
+  // Test: unknown commands get an error, and the next command still works
+  //
+  task automatic test_unknown_op();
+    send_byte(8'hDB);
+    send_byte(8'h7F);
+    expect_rsp(8'h01);
+
+    send_byte(8'hDB);
+    send_byte(8'h0A);
+    expect_rsp(8'h00);
+    expect_byte(8'h1F);
+
+    // log2 of RX_FIFO_DEPTH
+    expect_byte(8'd6);
+  endtask
+
+  //
+  // Test: bytes before the magic are skipped
+  //
+  task automatic test_resync();
+    send_byte(8'h00);
+    send_byte(8'h55);
+    send_byte(8'hDB);
+    send_byte(8'h00);
+    expect_rsp(8'h00);
+    expect_byte(8'h03);
+  endtask
+
+  //
+  // Test: every token type, including an overlapping copy
+  //
+  task automatic test_z_burst();
+    logic [31:0] expected[13];
+    int          start;
+
+    // literal 2, repeat 3, zero 2, copy 4 from 5 back, copy 2 from 1 back
+    expected = '{
+        32'h11,
+        32'h22,
+        32'h33,
+        32'h33,
+        32'h33,
+        32'h0,
+        32'h0,
+        32'h33,
+        32'h33,
+        32'h33,
+        32'h0,
+        32'h0,
+        32'h0
+    };
+
+    for (int i = 0; i < 13; i++) begin
+      mem[16+i] = 32'hFFFFFFFF;
+    end
+
+    start = bursts;
+    send_z_burst(8'h03, 32'h40, 13, '{
+                 8'h01, 8'h11, 8'h00, 8'h00, 8'h00, 8'h22, 8'h00, 8'h00, 8'h00,
+                 8'h42, 8'h33, 8'h00, 8'h00, 8'h00,
+                 8'h81,
+                 8'hC3, 8'h04,
+                 8'hC1, 8'h00
+                 });
+    expect_rsp(8'h00);
+    expect_byte(8'h03);
+
+    for (int i = 0; i < 13; i++) begin
+      `CHECK_EQ(mem[16+i], expected[i]);
+    end
+    `CHECK_EQ(bursts, start + 1);
+  endtask
+
+  //
+  // Test: a stream that ends early is an error; the burst is zero padded
+  // and the next command still works
+  //
+  task automatic test_z_short();
+    mem[2] = 32'hFFFFFFFF;
+
+    send_z_burst(8'h04, 32'h0, 3, '{8'h01, 8'h01, 8'h00, 8'h00, 8'h00,
+                                    8'h02, 8'h00, 8'h00, 8'h00});
+    expect_rsp(8'h01);
+    expect_byte(8'h04);
+    `CHECK_EQ(mem[0], 32'h1);
+    `CHECK_EQ(mem[1], 32'h2);
+    `CHECK_EQ(mem[2], 32'h0);
+
+    // Cut off in the middle of a literal word
+    send_z_burst(8'h05, 32'h0, 1, '{8'h00, 8'h01, 8'h00});
+    expect_rsp(8'h01);
+    expect_byte(8'h05);
+
+    send_byte(8'hDB);
+    send_byte(8'h00);
+    expect_rsp(8'h00);
+    expect_byte(8'h03);
+  endtask
+
+  //
+  // Test: copies from before the burst and words past len are errors
+  //
+  task automatic test_z_errors();
+    send_z_burst(8'h06, 32'h0, 2, '{8'h00, 8'h09, 8'h00, 8'h00, 8'h00,
+                                    8'hC0, 8'h01});
+    expect_rsp(8'h01);
+    expect_byte(8'h06);
+
+    send_z_burst(8'h07, 32'h0, 2, '{8'h83});
+    expect_rsp(8'h01);
+    expect_byte(8'h07);
+
+    send_z_burst(8'h08, 32'h0, 4, '{8'h83});
+    expect_rsp(8'h00);
+    expect_byte(8'h08);
+  endtask
+
+  //
+  // Test: block CRCs match zlib.crc32 of the little endian words, in both
+  // memories
+  //
+  task automatic test_crc();
+    send_burst(32'h40, 8, 32'h100);
+    expect_rsp(8'h00);
+
+    // zlib.crc32(struct.pack("<4I", 0x100, 0x101, 0x102, 0x103)) etc.
+    send_crc(32'h40, 4, 2);
+    expect_rsp(8'h00);
+    expect_u32(32'hF84ECA02);
+    expect_u32(32'h24512457);
+
+    // A single word in DMEM, and a block of zeros
+    send_burst(32'(MEM_WORDS * 2), 1, 32'hDEADBEEF);
+    expect_rsp(8'h00);
+    send_crc(32'(MEM_WORDS * 2), 1, 1);
+    expect_rsp(8'h00);
+    expect_u32(32'h1A5A601F);
+
+    for (int i = 0; i < 4; i++) begin
+      mem[MEM_WORDS/2+4+i] = 32'h0;
+    end
+    send_crc(32'(MEM_WORDS * 2 + 16), 4, 1);
+    expect_rsp(8'h00);
+    expect_u32(32'hECBB4B55);
+  endtask
+
+  //
+  // Test: bad ranges are errors, and still carry a CRC for every block
+  //
+  task automatic test_crc_errors();
+    // Straddles IMEM and DMEM
+    send_crc(32'(MEM_WORDS * 2 - 8), 4, 1);
+    expect_rsp(8'h01);
+    skip_bytes(4);
+
+    // Past the end, unaligned, empty blocks
+    send_crc(32'(MEM_WORDS * 4 - 8), 4, 2);
+    expect_rsp(8'h01);
+    skip_bytes(8);
+
+    send_crc(32'h2, 1, 1);
+    expect_rsp(8'h01);
+    skip_bytes(4);
+
+    send_crc(32'h0, 0, 1);
+    expect_rsp(8'h01);
+    skip_bytes(4);
+
+    // No blocks: just the status
+    send_crc(32'h0, 1, 0);
+    expect_rsp(8'h01);
+
+    send_byte(8'hDB);
+    send_byte(8'h00);
+    expect_rsp(8'h00);
+    expect_byte(8'h03);
+    `CHECK_EQ(host_rx.size(), 0);
+  endtask
+
+  //
+  // Test: fills write the value to the range and nothing past it, in both
+  // memories
+  //
+  task automatic test_fill();
+    int start;
+
+    for (int i = 0; i < 12; i++) begin
+      mem[15+i]            = 32'h0;
+      mem[MEM_WORDS/2+1+i] = 32'h0;
+    end
+
+    start = bursts;
+    send_fill(8'h0A, 32'h40, 32'd10, 32'hA5A5A5A5);
+    send_fill(8'h0B, 32'(MEM_WORDS * 2 + 8), 32'd3, 32'h7);
+    expect_rsp(8'h00);
+    expect_byte(8'h0A);
+    expect_rsp(8'h00);
+    expect_byte(8'h0B);
+
+    `CHECK_EQ(mem[15], 32'h0);
+    for (int i = 0; i < 10; i++) begin
+      `CHECK_EQ(mem[16+i], 32'hA5A5A5A5);
+    end
+    `CHECK_EQ(mem[26], 32'h0);
+
+    `CHECK_EQ(mem[MEM_WORDS/2+1], 32'h0);
+    for (int i = 0; i < 3; i++) begin
+      `CHECK_EQ(mem[MEM_WORDS/2+2+i], 32'h7);
+    end
+    `CHECK_EQ(mem[MEM_WORDS/2+5], 32'h0);
+    `CHECK_EQ(bursts, start + 2);
+  endtask
+
+  //
+  // Test: empty fills are acked, bad ranges acked with an error, neither
+  // reaching the bridge
+  //
+  task automatic test_fill_errors();
+    int start;
+
+    start = rx_count;
+    send_fill(8'h10, 32'h0, 32'd0, 32'h1);
+    expect_rsp(8'h00);
+    expect_byte(8'h10);
+
+    // Straddles IMEM and DMEM, past the end, unaligned, huge
+    send_fill(8'h11, 32'(MEM_WORDS * 2 - 8), 32'd4, 32'h1);
+    expect_rsp(8'h01);
+    expect_byte(8'h11);
+
+    send_fill(8'h12, 32'(MEM_WORDS * 4 - 8), 32'd4, 32'h1);
+    expect_rsp(8'h01);
+    expect_byte(8'h12);
+
+    send_fill(8'h13, 32'h2, 32'd1, 32'h1);
+    expect_rsp(8'h01);
+    expect_byte(8'h13);
+
+    send_fill(8'h14, 32'h0, 32'h40000000, 32'h1);
+    expect_rsp(8'h01);
+    expect_byte(8'h14);
+    `CHECK_EQ(rx_count, start);
+  endtask
+
+  //
+  // Test: single and burst reads return what was written, in both
+  // memories
+  //
+  task automatic test_read();
+    send_burst(32'h20, 6, 32'h1000);
+    expect_rsp(8'h00);
+
+    send_read(32'h24);
+    expect_rsp(8'h00);
+    expect_u32(32'h1001);
+
+    send_read_burst(32'h20, 6);
+    expect_rsp(8'h00);
+    for (int i = 0; i < 6; i++) begin
+      expect_u32(32'h1000 + 32'(i));
+    end
+
+    send_burst(32'(MEM_WORDS * 2), 2, 32'hCAFE0000);
+    expect_rsp(8'h00);
+
+    send_read_burst(32'(MEM_WORDS * 2), 2);
+    expect_rsp(8'h00);
+    expect_u32(32'hCAFE0000);
+    expect_u32(32'hCAFE0001);
+
+    send_read(32'(MEM_WORDS * 2 + 4));
+    expect_rsp(8'h00);
+    expect_u32(32'hCAFE0001);
+  endtask
+
+  //
+  // Test: bad ranges are errors, and still carry every word
+  //
+  task automatic test_read_errors();
+    // Past the end, unaligned
+    send_read(32'(MEM_WORDS * 4));
+    expect_rsp(8'h01);
+    skip_bytes(4);
+
+    send_read(32'h2);
+    expect_rsp(8'h01);
+    skip_bytes(4);
+
+    // Straddles IMEM and DMEM, runs past the end
+    send_read_burst(32'(MEM_WORDS * 2 - 4), 2);
+    expect_rsp(8'h01);
+    skip_bytes(8);
+
+    send_read_burst(32'(MEM_WORDS * 4 - 4), 2);
+    expect_rsp(8'h01);
+    skip_bytes(8);
+
+    // Empty: just the status
+    send_read_burst(32'h0, 0);
+    expect_rsp(8'h01);
+
+    send_byte(8'hDB);
+    send_byte(8'h00);
+    expect_rsp(8'h00);
+    expect_byte(8'h03);
+    `CHECK_EQ(host_rx.size(), 0);
+  endtask
+
+  `TEST_SUITE_BEGIN(svc_soc_dbg_ext_tb);
+  `TEST_CASE(test_caps);
+  `TEST_CASE(test_ctrl_passthrough);
+  `TEST_CASE(test_write_passthrough);
+  `TEST_CASE(test_seq_bursts);
+  `TEST_CASE(test_seq_burst_error);
+  `TEST_CASE(test_seq_burst_empty);
+  `TEST_CASE(test_z_burst);
+  `TEST_CASE(test_z_short);
+  `TEST_CASE(test_z_errors);
+  `TEST_CASE(test_crc);
+  `TEST_CASE(test_crc_errors);
+  `TEST_CASE(test_fill);
+  `TEST_CASE(test_fill_errors);
+  `TEST_CASE(test_read);
+  `TEST_CASE(test_read_errors);
+  `TEST_CASE(test_unknown_op);
+  `TEST_CASE(test_resync);
+  `TEST_SUITE_END();
+
+endmodule
@@ -18,24 +18,26 @@ module svc_soc_io_reg_tb;
   logic        uart_tx;
   /* verilator lint_on UNUSEDSIGNAL */
   logic        uart_rx;
+  logic [ 6:0] perf_events;
 
   svc_soc_io_reg #(
       .CLOCK_FREQ(100_000_000),
       .BAUD_RATE (115_200)
   ) uut (
-      .clk     (clk),
-      .rst_n   (rst_n),
-      .io_wen  (io_wen),
-      .io_waddr(io_waddr),
-      .io_wdata(io_wdata),
-      .io_wstrb(io_wstrb),
-      .io_ren  (io_ren),
-      .io_raddr(io_raddr),
-      .io_rdata(io_rdata),
-      .led     (led),
-      .gpio    (gpio),
-      .uart_tx (uart_tx),
-      .uart_rx (uart_rx)
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (led),
+      .gpio       (gpio),
+      .uart_tx    (uart_tx),
+      .uart_rx    (uart_rx),
+      .perf_events(perf_events)
   );
 
   //
@@ -43,13 +45,14 @@ module svc_soc_io_reg_tb;
   //
   always_ff @(posedge clk) begin
     if (~rst_n) begin
-      io_wen   <= 1'b0;
-      io_waddr <= 32'h0;
-      io_wdata <= 32'h0;
-      io_wstrb <= 4'h0;
-      io_ren   <= 1'b0;
-      io_raddr <= 32'h0;
-      uart_rx  <= 1'b1;
+      io_wen      <= 1'b0;
+      io_waddr    <= 32'h0;
+      io_wdata    <= 32'h0;
+      io_wstrb    <= 4'h0;
+      io_ren      <= 1'b0;
+      io_raddr    <= 32'h0;
+      uart_rx     <= 1'b1;
+      perf_events <= 7'h0;
     end
   end
 
@@ -317,6 +320,225 @@ module svc_soc_io_reg_tb;
     `TICK(clk);
   endtask
 
+  //
+  // Read a register (BRAM timing: data valid after one clock)
+  //
+  task automatic read_reg(input logic [31:0] addr, output logic [31:0] data);
+    io_ren   = 1'b1;
+    io_raddr = addr;
+
+    `TICK(clk);
+
+    data   = io_rdata;
+    io_ren = 1'b0;
+
+    `TICK(clk);
+  endtask
+
+  //
+  // Test packed TX register pushes 4 bytes into the FIFO
+  //
+  task automatic test_uart_packed_write();
+    logic [31:0] status;
+
+    read_reg(32'h80000004, status);
+    `CHECK_EQ(status[15:8], 8'd16);
+
+    io_wen   = 1'b1;
+    io_waddr = 32'h8000001C;
+    io_wdata = 32'h44434241;  // "ABCD"
+    io_wstrb = 4'hF;
+
+    `TICK(clk);
+
+    io_wen = 1'b0;
+
+    `TICK(clk);
+
+    // The transmitter may already have taken the first byte
+    read_reg(32'h80000004, status);
+    `CHECK_EQ(status[0], 1'b1);
+    `CHECK_EQ(status[1], 1'b0);
+    `CHECK_LT(status[15:8], 8'd14);
+    `CHECK_GT(status[15:8], 8'd11);
+  endtask
+
+  //
+  // Test strobe selects the bytes pushed by the packed TX register
+  //
+  task automatic test_uart_packed_strobe();
+    logic [31:0] before;
+    logic [31:0] after;
+
+    read_reg(32'h80000004, before);
+
+    io_wen   = 1'b1;
+    io_waddr = 32'h8000001C;
+    io_wdata = 32'h44434241;
+    io_wstrb = 4'b0101;
+
+    `TICK(clk);
+
+    io_wen = 1'b0;
+
+    `TICK(clk);
+
+    read_reg(32'h80000004, after);
+    `CHECK_EQ(before[15:8] - after[15:8], 8'd2);
+  endtask
+
+  //
+  // Test TX FIFO fills, reports not ready, and drops overflow
+  //
+  task automatic test_uart_tx_full();
+    logic [31:0] status;
+
+    io_wen   = 1'b1;
+    io_waddr = 32'h8000001C;
+    io_wdata = 32'h30313233;
+    io_wstrb = 4'hF;
+
+    for (int i = 0; i < 6; i++) begin
+      `TICK(clk);
+    end
+
+    io_wen = 1'b0;
+
+    `TICK(clk);
+
+    read_reg(32'h80000004, status);
+    `CHECK_EQ(status[0], 1'b0);
+    `CHECK_EQ(status[15:8], 8'd0);
+  endtask
+
+  //
+  // Drive one 8N1 frame on uart_rx
+  //
+  task automatic send_rx_byte(input logic [7:0] data,
+                              input int bit_cycles = 100_000_000 / 115_200);
+    uart_rx = 1'b0;
+    for (int c = 0; c < bit_cycles; c++) begin
+      `TICK(clk);
+    end
+
+    for (int b = 0; b < 8; b++) begin
+      uart_rx = data[b];
+      for (int c = 0; c < bit_cycles; c++) begin
+        `TICK(clk);
+      end
+    end
+
+    uart_rx = 1'b1;
+    for (int c = 0; c < 2 * bit_cycles; c++) begin
+      `TICK(clk);
+    end
+  endtask
+
+  //
+  // Test received bytes queue in the RX FIFO
+  //
+  task automatic test_uart_rx_fifo();
+    logic [31:0] status;
+    logic [31:0] data;
+
+    read_reg(32'h80000018, status);
+    `CHECK_EQ(status[0], 1'b0);
+
+    send_rx_byte(8'h5A);
+    send_rx_byte(8'hC3);
+
+    read_reg(32'h80000018, status);
+    `CHECK_EQ(status[0], 1'b1);
+    `CHECK_EQ(status[15:8], 8'd2);
+
+    read_reg(32'h80000014, data);
+    `CHECK_EQ(data, 32'h0000005A);
+
+    read_reg(32'h80000014, data);
+    `CHECK_EQ(data, 32'h000000C3);
+
+    read_reg(32'h80000018, status);
+    `CHECK_EQ(status[0], 1'b0);
+    `CHECK_EQ(status[15:8], 8'd0);
+  endtask
+
+  //
+  // Test the baud divisor register and receiving at a runtime rate
+  //
+  task automatic test_uart_baud_div();
+    logic [31:0] data;
+
+    read_reg(32'h80000020, data);
+    `CHECK_EQ(data, 32'(100_000_000 / 115_200));
+
+    io_wen   = 1'b1;
+    io_waddr = 32'h80000020;
+    io_wdata = 32'd16;
+    io_wstrb = 4'hF;
+
+    `TICK(clk);
+
+    // Below the minimum: ignored
+    io_wdata = 32'd2;
+
+    `TICK(clk);
+
+    io_wen = 1'b0;
+
+    `TICK(clk);
+
+    read_reg(32'h80000020, data);
+    `CHECK_EQ(data, 32'd16);
+
+    send_rx_byte(8'hA5, 16);
+
+    read_reg(32'h80000014, data);
+    `CHECK_EQ(data, 32'h000000A5);
+  endtask
+
+  //
+  // Test stall attribution counters (0x50-0x68, cleared by 0x6C)
+  //
+  task automatic test_perf_counters();
+    logic [31:0] data;
+
+    // Event i high for i + 1 cycles
+    for (int c = 0; c < 7; c++) begin
+      for (int i = 0; i < 7; i++) begin
+        perf_events[i] = (c <= i);
+      end
+
+      `TICK(clk);
+    end
+
+    perf_events = 7'h0;
+
+    for (int i = 0; i < 7; i++) begin
+      read_reg(32'h80000050 + 32'(4 * i), data);
+      `CHECK_EQ(data, 32'(i + 1));
+    end
+
+    // Holds while no events are raised
+    read_reg(32'h80000050, data);
+    `CHECK_EQ(data, 32'd1);
+
+    io_wen   = 1'b1;
+    io_waddr = 32'h8000006C;
+    io_wdata = 32'h0;
+    io_wstrb = 4'hF;
+
+    `TICK(clk);
+
+    io_wen = 1'b0;
+
+    `TICK(clk);
+
+    for (int i = 0; i < 7; i++) begin
+      read_reg(32'h80000050 + 32'(4 * i), data);
+      `CHECK_EQ(data, 32'h0);
+    end
+  endtask
+
   `TEST_SUITE_BEGIN(svc_soc_io_reg_tb);
   `TEST_CASE(test_reset);
   `TEST_CASE(test_write_led);
@@ -328,6 +550,12 @@ module svc_soc_io_reg_tb;
   `TEST_CASE(test_invalid_address);
   `TEST_CASE(test_uart_status);
   `TEST_CASE(test_uart_write);
+  `TEST_CASE(test_uart_packed_write);
+  `TEST_CASE(test_uart_packed_strobe);
+  `TEST_CASE(test_uart_tx_full);
+  `TEST_CASE(test_uart_rx_fifo);
+  `TEST_CASE(test_uart_baud_div);
+  `TEST_CASE(test_perf_counters);
   `TEST_SUITE_END();
 
 endmodule
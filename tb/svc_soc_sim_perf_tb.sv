@@ -0,0 +1,343 @@
+`include "svc_unit.sv"
+`include "svc_soc_io_reg.sv"
+`include "svc_soc_sim_perf.sv"
+
+module svc_soc_sim_perf_tb;
+  `TEST_CLK_NS(clk, 10);
+  `TEST_RST_N(clk, rst_n);
+
+  // Instructions
+  localparam logic [31:0] LW_X5 = 32'h00012283;  // lw   x5, 0(x2)
+  localparam logic [31:0] LW_X0 = 32'h00012003;  // lw   x0, 0(x2)
+  localparam logic [31:0] ADD_RS1 = 32'h00128333;  // add  x6, x5, x1
+  localparam logic [31:0] ADD_RS2 = 32'h00508333;  // add  x6, x1, x5
+  localparam logic [31:0] ADD_X0 = 32'h00100333;  // add  x6, x0, x1
+  localparam logic [31:0] ADDI = 32'h00100393;  // addi x7, x0, 1
+  localparam logic [31:0] BEQ = 32'h00000063;  // beq  x0, x0, 0
+  localparam logic [31:0] JAL = 32'h000000EF;  // jal  x1, 0
+  localparam logic [31:0] RET = 32'h00008067;  // jalr x0, 0(x1)
+  localparam logic [31:0] CALLR = 32'h000280E7;  // jalr x1, 0(x5)
+
+  // Counter registers
+  localparam logic [31:0] PERF_LOAD_USE = 32'h80000050;
+  localparam logic [31:0] PERF_MISPREDICT = 32'h80000054;
+  localparam logic [31:0] PERF_BTB_MISS = 32'h80000058;
+  localparam logic [31:0] PERF_RAS_MISS = 32'h8000005C;
+  localparam logic [31:0] PERF_ICACHE_MISS = 32'h80000060;
+  localparam logic [31:0] PERF_DCACHE_MISS = 32'h80000064;
+  localparam logic [31:0] PERF_MEM_WAIT = 32'h80000068;
+  localparam logic [31:0] PERF_CTRL = 32'h8000006C;
+
+  logic        retire_valid;
+  logic [31:0] retire_insn;
+  logic        m_axi_arvalid;
+  logic        m_axi_arready;
+  logic        m_axi_rvalid;
+  logic        m_axi_rready;
+  logic        m_axi_rlast;
+  logic        m_axi_awvalid;
+  logic        m_axi_awready;
+  logic        m_axi_wvalid;
+  logic        m_axi_bvalid;
+  logic        m_axi_bready;
+  logic [ 6:0] perf_events;
+
+  logic        io_wen;
+  logic [31:0] io_waddr;
+  logic [31:0] io_wdata;
+  logic [ 3:0] io_wstrb;
+  logic        io_ren;
+  logic [31:0] io_raddr;
+  logic [31:0] io_rdata;
+  /* verilator lint_off UNUSEDSIGNAL */
+  logic        led;
+  logic [ 7:0] gpio;
+  logic        uart_tx;
+  /* verilator lint_on UNUSEDSIGNAL */
+
+  svc_soc_sim_perf uut (
+      .clk          (clk),
+      .rst_n        (rst_n),
+      .retire_valid (retire_valid),
+      .retire_insn  (retire_insn),
+      .m_axi_arvalid(m_axi_arvalid),
+      .m_axi_arready(m_axi_arready),
+      .m_axi_rvalid (m_axi_rvalid),
+      .m_axi_rready (m_axi_rready),
+      .m_axi_rlast  (m_axi_rlast),
+      .m_axi_awvalid(m_axi_awvalid),
+      .m_axi_awready(m_axi_awready),
+      .m_axi_wvalid (m_axi_wvalid),
+      .m_axi_bvalid (m_axi_bvalid),
+      .m_axi_bready (m_axi_bready),
+      .perf_events  (perf_events)
+  );
+
+  // The counters as software reads them
+  svc_soc_io_reg #(
+      .CLOCK_FREQ(100_000_000),
+      .BAUD_RATE (115_200)
+  ) io_regs (
+      .clk        (clk),
+      .rst_n      (rst_n),
+      .io_wen     (io_wen),
+      .io_waddr   (io_waddr),
+      .io_wdata   (io_wdata),
+      .io_wstrb   (io_wstrb),
+      .io_ren     (io_ren),
+      .io_raddr   (io_raddr),
+      .io_rdata   (io_rdata),
+      .led        (led),
+      .gpio       (gpio),
+      .uart_tx    (uart_tx),
+      .uart_rx    (1'b1),
+      .perf_events(perf_events)
+  );
+
+  //
+  // Initialize signals in reset
+  //
+  always_ff @(posedge clk) begin
+    if (~rst_n) begin
+      retire_valid  <= 1'b0;
+      retire_insn   <= 32'h0;
+      m_axi_arvalid <= 1'b0;
+      m_axi_arready <= 1'b0;
+      m_axi_rvalid  <= 1'b0;
+      m_axi_rready  <= 1'b0;
+      m_axi_rlast   <= 1'b0;
+      m_axi_awvalid <= 1'b0;
+      m_axi_awready <= 1'b0;
+      m_axi_wvalid  <= 1'b0;
+      m_axi_bvalid  <= 1'b0;
+      m_axi_bready  <= 1'b0;
+      io_wen        <= 1'b0;
+      io_waddr      <= 32'h0;
+      io_wdata      <= 32'h0;
+      io_wstrb      <= 4'h0;
+      io_ren        <= 1'b0;
+      io_raddr      <= 32'h0;
+    end
+  end
+
+  task automatic retire(input logic [31:0] insn);
+    retire_valid = 1'b1;
+    retire_insn  = insn;
+
+    `TICK(clk);
+
+    retire_valid = 1'b0;
+  endtask
+
+  task automatic idle(input int cycles);
+    for (int i = 0; i < cycles; i++) begin
+      `TICK(clk);
+    end
+  endtask
+
+  task automatic read_reg(input logic [31:0] addr, output logic [31:0] data);
+    io_ren   = 1'b1;
+    io_raddr = addr;
+
+    `TICK(clk);
+
+    data   = io_rdata;
+    io_ren = 1'b0;
+
+    `TICK(clk);
+  endtask
+
+  //
+  // Retire an instruction that explains no gap, let pending events drain,
+  // then clear the counters
+  //
+  task automatic clear();
+    retire(ADDI);
+    idle(16);
+
+    io_wen   = 1'b1;
+    io_waddr = PERF_CTRL;
+    io_wdata = 32'h0;
+    io_wstrb = 4'hF;
+
+    `TICK(clk);
+
+    io_wen = 1'b0;
+  endtask
+
+  task automatic check_counts(input int load_use, input int mispredict,
+                              input int btb_miss, input int ras_miss,
+                              input int dcache_miss, input int mem_wait);
+    logic [31:0] data;
+
+    // Let the last gap drain
+    idle(16);
+
+    read_reg(PERF_LOAD_USE, data);
+    `CHECK_EQ(data, 32'(load_use));
+    read_reg(PERF_MISPREDICT, data);
+    `CHECK_EQ(data, 32'(mispredict));
+    read_reg(PERF_BTB_MISS, data);
+    `CHECK_EQ(data, 32'(btb_miss));
+    read_reg(PERF_RAS_MISS, data);
+    `CHECK_EQ(data, 32'(ras_miss));
+    read_reg(PERF_ICACHE_MISS, data);
+    `CHECK_EQ(data, 32'h0);
+    read_reg(PERF_DCACHE_MISS, data);
+    `CHECK_EQ(data, 32'(dcache_miss));
+    read_reg(PERF_MEM_WAIT, data);
+    `CHECK_EQ(data, 32'(mem_wait));
+  endtask
+
+  //
+  // Back-to-back retires charge nothing
+  //
+  task automatic test_no_gap();
+    clear();
+
+    retire(LW_X5);
+    retire(ADD_RS1);
+    retire(BEQ);
+    retire(ADDI);
+    retire(JAL);
+    retire(ADDI);
+    retire(RET);
+    retire(ADDI);
+
+    check_counts(0, 0, 0, 0, 0, 0);
+  endtask
+
+  //
+  // A load followed by a reader of its rd, through rs1 or rs2
+  //
+  task automatic test_load_use();
+    clear();
+
+    retire(LW_X5);
+    idle(2);
+    retire(ADD_RS1);
+
+    retire(LW_X5);
+    idle(1);
+    retire(ADD_RS2);
+
+    check_counts(3, 0, 0, 0, 0, 0);
+
+    // Not charged: independent next instruction, or a load to x0
+    retire(LW_X5);
+    idle(3);
+    retire(ADDI);
+
+    retire(LW_X0);
+    idle(3);
+    retire(ADD_X0);
+
+    check_counts(3, 0, 0, 0, 0, 0);
+  endtask
+
+  //
+  // A gap after a conditional branch
+  //
+  task automatic test_mispredict();
+    clear();
+
+    retire(BEQ);
+    idle(2);
+    retire(ADDI);
+
+    retire(BEQ);
+    idle(2);
+    retire(BEQ);
+    idle(1);
+    retire(ADDI);
+
+    check_counts(0, 5, 0, 0, 0, 0);
+  endtask
+
+  //
+  // Gaps after jal and indirect calls are BTB misses, after returns RAS
+  // misses
+  //
+  task automatic test_jumps();
+    clear();
+
+    retire(JAL);
+    idle(1);
+    retire(ADDI);
+
+    retire(CALLR);
+    idle(2);
+    retire(ADDI);
+
+    retire(RET);
+    idle(3);
+    retire(ADDI);
+
+    check_counts(0, 0, 3, 3, 0, 0);
+  endtask
+
+  //
+  // A cache refill and a write-back, with a load waiting on the refill:
+  // the refill cycles are memory time, not load-use
+  //
+  task automatic test_axi();
+    clear();
+
+    retire(LW_X5);
+
+    // Refill: AR accepted, 3 cycles later the last beat
+    m_axi_arvalid = 1'b1;
+    m_axi_arready = 1'b1;
+
+    `TICK(clk);
+
+    m_axi_arvalid = 1'b0;
+    m_axi_arready = 1'b0;
+    idle(2);
+    m_axi_rvalid = 1'b1;
+    m_axi_rready = 1'b1;
+    m_axi_rlast  = 1'b1;
+
+    `TICK(clk);
+
+    m_axi_rvalid = 1'b0;
+    m_axi_rready = 1'b0;
+    m_axi_rlast  = 1'b0;
+    retire(ADD_RS1);
+
+    check_counts(0, 0, 0, 0, 4, 4);
+
+    // Write-back: AW and W accepted, response 2 cycles later
+    m_axi_awvalid = 1'b1;
+    m_axi_awready = 1'b1;
+    m_axi_wvalid  = 1'b1;
+
+    `TICK(clk);
+
+    m_axi_awvalid = 1'b0;
+    m_axi_awready = 1'b0;
+    m_axi_wvalid  = 1'b0;
+
+    `TICK(clk);
+
+    m_axi_bvalid = 1'b1;
+    m_axi_bready = 1'b1;
+
+    `TICK(clk);
+
+    m_axi_bvalid = 1'b0;
+    m_axi_bready = 1'b0;
+    retire(ADDI);
+
+    check_counts(0, 0, 0, 0, 4, 7);
+  endtask
+
+  `TEST_SUITE_BEGIN(svc_soc_sim_perf_tb);
+  `TEST_CASE(test_no_gap);
+  `TEST_CASE(test_load_use);
+  `TEST_CASE(test_mispredict);
+  `TEST_CASE(test_jumps);
+  `TEST_CASE(test_axi);
+  `TEST_SUITE_END();
+
+endmodule